@@ -6,10 +6,12 @@
 #include "BattleGroundTactics.h"
 
 #include <algorithm>
+#include <queue>
 
 #include "ArenaTeam.h"
 #include "ArenaTeamMgr.h"
 #include "BattleGroundJoinAction.h"
+#include "BattleGroundTeamPlanner.h"
 #include "Battleground.h"
 #include "BattlegroundAB.h"
 #include "BattlegroundAV.h"
@@ -1204,6 +1206,250 @@ std::vector<BattleBotPath*> const vPaths_NoReverseAllowed = {
     &vPath_IC_Docks_Graveyard_to_Docks_Flag,
 };
 
+// Gaps wider than END_JOIN_DISTANCE that are open ground, joined both ways
+struct BattleBotWaypointLink
+{
+    BattleBotPath* fromPath;
+    uint32 fromIndex;
+    BattleBotPath* toPath;
+    uint32 toIndex;
+};
+
+static std::vector<BattleBotWaypointLink> const vWaypointLinks = {
+    // Horde keep door to the start of the keep path, 30 yards of flat courtyard
+    {&vPath_IC_Horde_Keep_to_Horde_Dock_Crossroad, 0, &vPath_IC_Horde_Base, 0},
+};
+
+static std::unordered_map<std::vector<BattleBotPath*> const*, BattleBotWaypointGraph> waypointGraphs;
+
+void BattleBotWaypointGraph::BuildAll()
+{
+    std::vector<std::pair<char const*, std::vector<BattleBotPath*> const*>> const battlegrounds = {
+        {"WS", &vPaths_WS}, {"AB", &vPaths_AB}, {"AV", &vPaths_AV}, {"EY", &vPaths_EY}, {"IC", &vPaths_IC}};
+
+    for (auto const& bg : battlegrounds)
+    {
+        BattleBotWaypointGraph& graph = waypointGraphs[bg.second];
+        graph.Build(*bg.second);
+
+        uint32 const components = graph.CountComponents();
+        if (components != 1)
+            LOG_ERROR("playerbots", "Battleground {} waypoint graph is split into {} parts", bg.first, components);
+        else
+            LOG_INFO("playerbots", ">> Battleground {} waypoint graph: {} waypoints", bg.first, graph.nodes.size());
+    }
+}
+
+BattleBotWaypointGraph const* BattleBotWaypointGraph::Get(std::vector<BattleBotPath*> const& paths)
+{
+    std::unordered_map<std::vector<BattleBotPath*> const*, BattleBotWaypointGraph>::const_iterator itr =
+        waypointGraphs.find(&paths);
+    return itr != waypointGraphs.end() ? &itr->second : nullptr;
+}
+
+void BattleBotWaypointGraph::Build(std::vector<BattleBotPath*> const& paths)
+{
+    nodes.clear();
+    for (BattleBotPath* path : paths)
+    {
+        bool const reverseAllowed = std::find(vPaths_NoReverseAllowed.begin(), vPaths_NoReverseAllowed.end(), path) ==
+                                    vPaths_NoReverseAllowed.end();
+        for (uint32 i = 0; i < path->size(); ++i)
+            nodes.push_back({path, i, reverseAllowed});
+    }
+
+    uint32 const count = nodes.size();
+    links.assign(count, {});
+    joined.assign(count, {});
+
+    // One way: the bot may step from `from` onto `to`
+    auto joinOneWay = [this](uint32 from, uint32 to, float length)
+    {
+        if (std::find(joined[from].begin(), joined[from].end(), to) != joined[from].end())
+            return;
+
+        links[from].emplace_back(to, length);
+        joined[from].push_back(to);
+    };
+    auto join = [&joinOneWay](uint32 from, uint32 to, float length)
+    {
+        joinOneWay(from, to, length);
+        joinOneWay(to, from, length);
+    };
+
+    for (uint32 from = 0; from < count; ++from)
+    {
+        BattleBotWaypoint const& a = GetWaypoint(from);
+        for (uint32 to = from + 1; to < count; ++to)
+        {
+            BattleBotWaypoint const& b = GetWaypoint(to);
+            float const length = Position(a.x, a.y, a.z).GetExactDist(b.x, b.y, b.z);
+            if (nodes[from].path == nodes[to].path)
+            {
+                if (nodes[to].index != nodes[from].index + 1)
+                    continue;
+
+                links[from].emplace_back(to, length);
+                if (nodes[from].reverseAllowed)
+                    links[to].emplace_back(from, length);
+            }
+            else if (length < JOIN_DISTANCE)
+                join(from, to, length);
+        }
+    }
+
+    // Paths often end a little further than JOIN_DISTANCE from the next one, so each path's ends are also joined to
+    // the nearest waypoint of every other path within END_JOIN_DISTANCE. A path that may not be walked backwards is
+    // only entered at its start and only left at its end.
+    for (uint32 from = 0; from < count; ++from)
+    {
+        bool const first = nodes[from].index == 0;
+        bool const last = nodes[from].index + 1 == nodes[from].path->size();
+        if (!first && !last)
+            continue;
+
+        BattleBotWaypoint const& a = GetWaypoint(from);
+        for (BattleBotPath* path : paths)
+        {
+            if (path == nodes[from].path)
+                continue;
+
+            uint32 nearest = count;
+            float nearestLength = END_JOIN_DISTANCE;
+            for (uint32 to = 0; to < count; ++to)
+            {
+                if (nodes[to].path != path)
+                    continue;
+
+                BattleBotWaypoint const& b = GetWaypoint(to);
+                float const length = Position(a.x, a.y, a.z).GetExactDist(b.x, b.y, b.z);
+                if (length < nearestLength)
+                {
+                    nearestLength = length;
+                    nearest = to;
+                }
+            }
+
+            if (nearest == count)
+                continue;
+
+            if (nodes[from].reverseAllowed || (first && last))
+                join(from, nearest, nearestLength);
+            else if (first)
+                joinOneWay(nearest, from, nearestLength);
+            else
+                joinOneWay(from, nearest, nearestLength);
+        }
+    }
+
+    for (BattleBotWaypointLink const& extra : vWaypointLinks)
+    {
+        uint32 from = count;
+        uint32 to = count;
+        for (uint32 node = 0; node < count; ++node)
+        {
+            if (nodes[node].path == extra.fromPath && nodes[node].index == extra.fromIndex)
+                from = node;
+            else if (nodes[node].path == extra.toPath && nodes[node].index == extra.toIndex)
+                to = node;
+        }
+
+        if (from == count || to == count)
+            continue;  // another battleground's link
+
+        BattleBotWaypoint const& a = GetWaypoint(from);
+        BattleBotWaypoint const& b = GetWaypoint(to);
+        join(from, to, Position(a.x, a.y, a.z).GetExactDist(b.x, b.y, b.z));
+    }
+
+    // Dijkstra from every waypoint, a few hundred per battleground
+    distances.assign(count * count, FLT_MAX);
+    typedef std::pair<float, uint32> QueueEntry;
+    for (uint32 source = 0; source < count; ++source)
+    {
+        float* dist = &distances[source * count];
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+        dist[source] = 0.0f;
+        queue.emplace(0.0f, source);
+        while (!queue.empty())
+        {
+            QueueEntry const top = queue.top();
+            queue.pop();
+            if (top.first > dist[top.second])
+                continue;
+
+            for (std::pair<uint32, float> const& link : links[top.second])
+            {
+                float const length = top.first + link.second;
+                if (length < dist[link.first])
+                {
+                    dist[link.first] = length;
+                    queue.emplace(length, link.first);
+                }
+            }
+        }
+    }
+}
+
+uint32 BattleBotWaypointGraph::CountComponents() const
+{
+    // Links taken both ways, a one way path still connects its waypoints
+    uint32 const count = nodes.size();
+    std::vector<std::vector<uint32>> neighbours(count);
+    for (uint32 from = 0; from < count; ++from)
+        for (std::pair<uint32, float> const& link : links[from])
+        {
+            neighbours[from].push_back(link.first);
+            neighbours[link.first].push_back(from);
+        }
+
+    std::vector<bool> visited(count, false);
+    uint32 components = 0;
+    for (uint32 start = 0; start < count; ++start)
+    {
+        if (visited[start])
+            continue;
+
+        ++components;
+        std::vector<uint32> stack(1, start);
+        visited[start] = true;
+        while (!stack.empty())
+        {
+            uint32 const node = stack.back();
+            stack.pop_back();
+            for (uint32 next : neighbours[node])
+                if (!visited[next])
+                {
+                    visited[next] = true;
+                    stack.push_back(next);
+                }
+        }
+    }
+
+    return components;
+}
+
+int32 BattleBotWaypointGraph::GetNearestNode(float x, float y, float z, float maxDistance) const
+{
+    int32 nearest = -1;
+    float nearestDistSq = maxDistance * maxDistance;
+    for (uint32 node = 0; node < nodes.size(); ++node)
+    {
+        BattleBotWaypoint const& waypoint = GetWaypoint(node);
+        float const dx = waypoint.x - x;
+        float const dy = waypoint.y - y;
+        float const dz = waypoint.z - z;
+        float const distSq = dx * dx + dy * dy + dz * dz;
+        if (distSq < nearestDistSq)
+        {
+            nearestDistSq = distSq;
+            nearest = node;
+        }
+    }
+
+    return nearest;
+}
+
 static std::vector<std::pair<uint8, uint32>> AV_AttackObjectives_Horde = {
     // Attack - these are in order they should be attacked
     {BG_AV_NODES_STONEHEART_GRAVE, BG_AV_OBJECT_FLAG_A_STONEHEART_GRAVE},
@@ -1732,7 +1978,7 @@ bool BGTactics::moveToStart(bool force)
 
     if (bgType == BATTLEGROUND_WS)
     {
-        uint32 role = context->GetValue<uint32>("bg role")->Get();
+        uint32 role = sBattleGroundTeamPlanner->GetAssignment(bot).role;
 
         int startSpot = role < 4 ? BB_WSG_WAIT_SPOT_LEFT : role > 6 ? BB_WSG_WAIT_SPOT_RIGHT : BB_WSG_WAIT_SPOT_SPAWN;
         if (startSpot == BB_WSG_WAIT_SPOT_RIGHT)
@@ -1802,7 +2048,7 @@ bool BGTactics::moveToStart(bool force)
     }
     else if (bgType == BATTLEGROUND_IC)
     {
-        uint32 role = context->GetValue<uint32>("bg role")->Get();
+        uint32 role = sBattleGroundTeamPlanner->GetAssignment(bot).role;
 
         if (bot->GetTeamId() == TEAM_HORDE)
         {
@@ -1853,6 +2099,23 @@ bool BGTactics::selectObjective(bool reset)
     if (pos.isSet() && !reset)
         return false;
 
+    BGTeamAssignment const assignment = sBattleGroundTeamPlanner->GetAssignment(bot);
+
+    // Escorts stay with the team's flag carrier until the planner hands them another task
+    if (assignment.task == BG_TASK_ESCORT)
+    {
+        Player* teamFC = ObjectAccessor::GetPlayer(bg->GetBgMap(), sBattleGroundTeamPlanner->GetFlagCarrier(bot));
+        if (teamFC && teamFC->IsAlive())
+        {
+            pos.Set(teamFC->GetPositionX(), teamFC->GetPositionY(), teamFC->GetPositionZ(), bot->GetMapId());
+            posMap["bg objective"] = pos;
+            if (sServerFacade->GetDistance2d(bot, teamFC) < 33.0f)
+                Follow(teamFC);
+
+            return true;
+        }
+    }
+
     WorldObject* BgObjective = nullptr;
 
     BattlegroundTypeId bgType = bg->GetBgTypeID();
@@ -1864,37 +2127,13 @@ bool BGTactics::selectObjective(bool reset)
         {
             BattlegroundAV* av = static_cast<BattlegroundAV*>(bg);
             TeamId team = bot->GetTeamId();
-            uint8 role = context->GetValue<uint32>("bg role")->Get();
-            AVBotStrategy strategyHorde = static_cast<AVBotStrategy>(GetBotStrategyForTeam(bg, TEAM_HORDE));
-            AVBotStrategy strategyAlliance = static_cast<AVBotStrategy>(GetBotStrategyForTeam(bg, TEAM_ALLIANCE));
-            AVBotStrategy strategy = (team == TEAM_ALLIANCE) ? strategyAlliance : strategyHorde;
-            AVBotStrategy enemyStrategy = (team == TEAM_ALLIANCE) ? strategyHorde : strategyAlliance;
+            uint8 role = assignment.role;
+            AVBotStrategy strategy = static_cast<AVBotStrategy>(GetBotStrategyForTeam(bg, team));
 
-            uint8 defendersProhab = 4;
-            bool enableMineCapture = true;
-            bool enableSnowfall = true;
+            bool enableMineCapture = strategy != AV_STRATEGY_OFFENSIVE;
+            bool enableSnowfall = strategy != AV_STRATEGY_DEFENSIVE;
 
-            switch (strategy)
-            {
-                case AV_STRATEGY_BALANCED:
-                    defendersProhab = 4;
-                    break;
-                case AV_STRATEGY_OFFENSIVE:
-                    defendersProhab = 1;
-                    enableMineCapture = false;
-                    break;
-                case AV_STRATEGY_DEFENSIVE:
-                    defendersProhab = 9;
-                    enableSnowfall = false;
-                    break;
-                default:
-                    break;
-            }
-
-            if (enemyStrategy == AV_STRATEGY_DEFENSIVE)
-                defendersProhab = 0;
-
-            bool isDefender = role < defendersProhab;
+            bool isDefender = assignment.task == BG_TASK_DEFEND;
             bool isAdvanced = !isDefender && role > 8;
 
             auto const& attackObjectives =
@@ -2169,39 +2408,10 @@ bool BGTactics::selectObjective(bool reset)
             bool hasFlag = bot->HasAura(BG_WS_SPELL_WARSONG_FLAG) || bot->HasAura(BG_WS_SPELL_SILVERWING_FLAG);
 
             // Retrieve role
-            uint8 role = context->GetValue<uint32>("bg role")->Get();
-            WSBotStrategy strategyHorde = static_cast<WSBotStrategy>(GetBotStrategyForTeam(bg, TEAM_HORDE));
-            WSBotStrategy strategyAlliance = static_cast<WSBotStrategy>(GetBotStrategyForTeam(bg, TEAM_ALLIANCE));
-            WSBotStrategy strategy = (team == TEAM_ALLIANCE) ? strategyAlliance : strategyHorde;
-            WSBotStrategy enemyStrategy = (team == TEAM_ALLIANCE) ? strategyHorde : strategyAlliance;
-
-            uint8 defendersProhab = 3;  // Default balanced
-
-            switch (strategy)
-            {
-                case 0:
-                case 1:
-                case 2:
-                case 3:  // Balanced
-                    defendersProhab = 3;
-                    break;
-                case 4:
-                case 5:
-                case 6:
-                case 7:  // Heavy Offense
-                    defendersProhab = 1;
-                    break;
-                case 8:
-                case 9:  // Heavy Defense
-                    defendersProhab = 6;
-                    break;
-            }
-
-            if (enemyStrategy == WS_STRATEGY_DEFENSIVE)
-                defendersProhab = 2;
+            uint8 role = assignment.role;
 
             // Role check
-            bool isDefender = role < defendersProhab;
+            bool isDefender = assignment.task == BG_TASK_DEFEND;
 
             // Retrieve flag carriers
             Unit* enemyFC = AI_VALUE(Unit*, "enemy flag carrier");
@@ -2215,15 +2425,8 @@ bool BGTactics::selectObjective(bool reset)
             bool bothFlagsTaken = enemyFC && teamFC;
             if (!hasFlag && bothFlagsTaken)
             {
-                // If both flags taken: Bots have 20% chance to support own flag carrier, otherwise attack enemy FC
-                if (urand(0, 99) < 20 && teamFC)
-                {
-                    target.Relocate(teamFC->GetPositionX(), teamFC->GetPositionY(), teamFC->GetPositionZ());
-                    if (sServerFacade->GetDistance2d(bot, teamFC) < 33.0f)
-                        Follow(teamFC);
-                }
-                else
-                    target.Relocate(enemyFC->GetPositionX(), enemyFC->GetPositionY(), enemyFC->GetPositionZ());
+                // If both flags taken: the escorts stay with our flag carrier, everyone else attacks enemy FC
+                target.Relocate(enemyFC->GetPositionX(), enemyFC->GetPositionY(), enemyFC->GetPositionZ());
             }
             // Graveyard Camping if in lead
             else if (!hasFlag && role < 8 &&
@@ -2257,19 +2460,9 @@ bool BGTactics::selectObjective(bool reset)
                         // 33% chance to roam near own base
                         SetSafePos(team == TEAM_ALLIANCE ? WS_FLAG_HIDE_ALLIANCE[urand(0, 2)] : WS_FLAG_HIDE_HORDE[urand(0, 2)], 5.0f);
                     }
-                    else if (teamFC)
-                    {
-                        // 70% chance to support own FC
-                        if (urand(0, 99) < 70)
-                        {
-                            target.Relocate(teamFC->GetPositionX(), teamFC->GetPositionY(), teamFC->GetPositionZ());
-                            if (sServerFacade->GetDistance2d(bot, teamFC) < 33.0f)
-                                Follow(teamFC);
-                        }
-                    }
                     else
                     {
-                        // Roam around central area
+                        // Roam around central area (own FC has its escorts)
                         SetSafePos(WS_ROAM_POS, 75.0f);
                     }
                 }
@@ -2318,22 +2511,7 @@ bool BGTactics::selectObjective(bool reset)
             BattlegroundAB* ab = static_cast<BattlegroundAB*>(bg);
             TeamId team = bot->GetTeamId();
 
-            uint8 role = context->GetValue<uint32>("bg role")->Get();
-            ABBotStrategy strategyHorde = static_cast<ABBotStrategy>(GetBotStrategyForTeam(bg, TEAM_HORDE));
-            ABBotStrategy strategyAlliance = static_cast<ABBotStrategy>(GetBotStrategyForTeam(bg, TEAM_ALLIANCE));
-            ABBotStrategy strategy = (team == TEAM_ALLIANCE) ? strategyAlliance : strategyHorde;
-            ABBotStrategy enemyStrategy = (team == TEAM_ALLIANCE) ? strategyHorde : strategyAlliance;
-
-            uint8 defendersProhab = 3;
-            if (strategy == AB_STRATEGY_OFFENSIVE)
-                defendersProhab = 1;
-            else if (strategy == AB_STRATEGY_DEFENSIVE)
-                defendersProhab = 6;
-
-            if (enemyStrategy == AB_STRATEGY_DEFENSIVE)
-                defendersProhab = 2;
-
-            bool isDefender = role < defendersProhab;
+            bool isDefender = assignment.task == BG_TASK_DEFEND;
             bool isSilly = urand(0, 99) < 20;
 
             BgObjective = nullptr;
@@ -2492,32 +2670,12 @@ bool BGTactics::selectObjective(bool reset)
         {
             BattlegroundEY* eyeOfTheStormBG = (BattlegroundEY*)bg;
             TeamId team = bot->GetTeamId();
-            uint8 role = context->GetValue<uint32>("bg role")->Get();
-
-            EYBotStrategy strategyHorde = static_cast<EYBotStrategy>(GetBotStrategyForTeam(bg, TEAM_HORDE));
-            EYBotStrategy strategyAlliance = static_cast<EYBotStrategy>(GetBotStrategyForTeam(bg, TEAM_ALLIANCE));
-            EYBotStrategy strategy = (team == TEAM_ALLIANCE) ? strategyAlliance : strategyHorde;
-            EYBotStrategy enemyStrategy = (team == TEAM_ALLIANCE) ? strategyHorde : strategyAlliance;
+            EYBotStrategy strategy = static_cast<EYBotStrategy>(GetBotStrategyForTeam(bg, team));
 
             auto IsOwned = [&](uint32 nodeId) -> bool
             { return eyeOfTheStormBG->GetCapturePointInfo(nodeId)._ownerTeamId == team; };
 
-            uint8 defendersProhab = 4;
-            switch (strategy)
-            {
-                case EY_STRATEGY_FLAG_FOCUS:
-                    defendersProhab = 2;
-                    break;
-                case EY_STRATEGY_FRONT_FOCUS:
-                case EY_STRATEGY_BACK_FOCUS:
-                    defendersProhab = 3;
-                    break;
-                default:
-                    defendersProhab = 4;
-                    break;
-            }
-
-            bool isDefender = role < defendersProhab;
+            bool isDefender = assignment.task == BG_TASK_DEFEND;
 
             std::tuple<uint32, uint32, uint32> front[2];
             std::tuple<uint32, uint32, uint32> back[2];
@@ -2846,7 +3004,7 @@ bool BGTactics::selectObjective(bool reset)
         {
             BattlegroundIC* isleOfConquestBG = (BattlegroundIC*)bg;
 
-            uint32 role = context->GetValue<uint32>("bg role")->Get();
+            uint32 role = assignment.role;
             bool inVehicle = botAI->IsInVehicle();
             bool controlsVehicle = botAI->IsInVehicle(true);
             uint32 vehicleId = inVehicle ? bot->GetVehicleBase()->GetEntry() : 0;
@@ -3257,136 +3415,83 @@ bool BGTactics::selectObjectiveWp(std::vector<BattleBotPath*> const& vPaths)
             return true;
     }
 
-    float chosenPathScore = FLT_MAX;  // lower score is better
+    BattleBotWaypointGraph const* graph = BattleBotWaypointGraph::Get(vPaths);
+    if (!graph)
+        return false;
+
+    float botDistanceLimit = 50.0f;  // limit for how far the waypoint the bot starts from can be
+    if (bgType == BATTLEGROUND_AV)
+        botDistanceLimit = 80.0f;
+
+    int32 const exit = getObjectiveWp(graph, pos);
+    int32 const entry = graph->GetNearestNode(bot->GetPositionX(), bot->GetPositionY(), bot->GetPositionZ(),
+                                              botDistanceLimit);
+
+    // don't pick a path when the bot is already at the waypoint closest to the objective (it can't lead it anywhere)
+    if (exit < 0 || entry < 0 || entry == exit)
+        return false;
+
+    // The bot may walk on from its waypoint, or from the waypoints of other paths joined to it, in either direction.
+    // The step that leaves the shortest walk to the objective's waypoint wins; reaching a joined waypoint counts too,
+    // path ends are joined over longer gaps.
     BattleBotPath* chosenPath = nullptr;
     uint32 chosenPathPoint = 0;
     bool chosenPathReverse = false;
+    float chosenPathScore = FLT_MAX;  // lower score is better
 
-    float botDistanceLimit = 50.0f;         // limit for how far path can be from bot
-    float botDistanceScoreSubtract = 8.0f;  // path score modifier - lower = less likely to chose a further path (it's
-                                            // basically the distance from bot that's ignored)
-    float botDistanceScoreMultiply =
-        3.0f;  // path score modifier - higher = less likely to chose a further path (it's basically a multiplier on
-               // distance from bot - makes distance from bot more signifcant than distance from destination)
-
-    if (bgType == BATTLEGROUND_IC)
-    {
-        // botDistanceLimit = 80.0f;
-        botDistanceScoreMultiply = 8.0f;
-        botDistanceScoreSubtract = 2.0f;
-    }
-    else if (bgType == BATTLEGROUND_AV)
-    {
-        botDistanceLimit = 80.0f;
-        botDistanceScoreMultiply = 8.0f;
-    }
-    else if (bgType == BATTLEGROUND_AB || bgType == BATTLEGROUND_EY || bgType == BATTLEGROUND_WS)
-    {
-        botDistanceScoreSubtract = 2.0f;
-        botDistanceScoreMultiply = 4.0f;
-    }
-
-    // uint32 index = -1;
-    // uint32 chosenPathIndex = -1;
-    for (auto const& path : vPaths)
+    std::vector<uint32> starts = graph->GetJoined(entry);
+    starts.push_back(entry);
+    for (uint32 start : starts)
     {
-        // index++;
-        // TODO need to remove sqrt from these two and distToBot but it totally throws path scoring out of
-        // whack if you do that without changing how its implemented (I'm amazed it works as well as it does
-        // using sqrt'ed distances)
-        // In a reworked version maybe compare the differences of path distances to point (ie: against best path)
-        // or maybe ratio's (where if a path end is twice the difference in distance from destination we basically
-        // use that to multiply the total score?
-        BattleBotWaypoint& startPoint = ((*path)[0]);
-        float const startPointDistToDestination =
-            sqrt(Position(pos.x, pos.y, pos.z, 0.f).GetExactDist(startPoint.x, startPoint.y, startPoint.z));
-        BattleBotWaypoint& endPoint = ((*path)[path->size() - 1]);
-        float const endPointDistToDestination =
-            sqrt(Position(pos.x, pos.y, pos.z, 0.f).GetExactDist(endPoint.x, endPoint.y, endPoint.z));
-
-        bool reverse = startPointDistToDestination < endPointDistToDestination;
-
-        // dont travel reverse if it's a reverse paths
-        if (reverse && std::find(vPaths_NoReverseAllowed.begin(), vPaths_NoReverseAllowed.end(), path) !=
-                           vPaths_NoReverseAllowed.end())
-            continue;
-
-        int closestPointIndex = -1;
-        float closestPointDistToBot = FLT_MAX;
-        for (uint32 i = 0; i < path->size(); i++)
+        BattleBotWaypointGraph::Node const& node = graph->GetNode(start);
+        BattleBotWaypoint const& waypoint = graph->GetWaypoint(start);
+        for (bool reverse : {false, true})
         {
-            BattleBotWaypoint& waypoint = ((*path)[i]);
-            float const distToBot = sqrt(bot->GetDistance(waypoint.x, waypoint.y, waypoint.z));
-            if (closestPointDistToBot > distToBot)
+            if (reverse ? (!node.index || !node.reverseAllowed) : node.index + 1 >= node.path->size())
+                continue;
+
+            uint32 const next = reverse ? start - 1 : start + 1;
+            BattleBotWaypoint const& nextWaypoint = graph->GetWaypoint(next);
+            float const pathScore =
+                graph->GetDistance(entry, start) +
+                Position(waypoint.x, waypoint.y, waypoint.z).GetExactDist(nextWaypoint.x, nextWaypoint.y,
+                                                                          nextWaypoint.z) +
+                graph->GetDistance(next, exit);
+            if (chosenPathScore > pathScore)
             {
-                closestPointDistToBot = distToBot;
-                closestPointIndex = i;
+                chosenPathScore = pathScore;
+                chosenPath = node.path;
+                chosenPathPoint = node.index;
+                chosenPathReverse = reverse;
             }
         }
-
-        // don't pick path where bot is already closest to the paths closest point to target (it means path cant lead it
-        // anywhere) don't pick path where closest point is too far away
-        if (closestPointIndex == (reverse ? 0 : path->size() - 1) || closestPointDistToBot > botDistanceLimit)
-            continue;
-
-        // creates a score based on dist-to-bot and dist-to-destination, where lower is better, and dist-to-bot is more
-        // important (when its beyond a certain distance) dist-to-bot is more important because otherwise they cant
-        // reach it at all (or will fly through air with MM::MovePoint()), also bot may need to use multiple paths (one
-        // after another) anyway
-        float distToDestination = reverse ? startPointDistToDestination : endPointDistToDestination;
-        float pathScore = (closestPointDistToBot < botDistanceScoreSubtract
-                               ? 0.0f
-                               : ((closestPointDistToBot - botDistanceScoreSubtract) * botDistanceScoreMultiply)) +
-                          distToDestination;
-
-        // LOG_INFO("playerbots", "bot={}\t{:6.1f}\t{:4.1f}\t{:4.1f}\t{}", bot->GetName(), pathScore,
-        // closestPointDistToBot, distToDestination, vPaths_AB_name[pathNum]);
-
-        if (chosenPathScore > pathScore)
-        {
-            chosenPathScore = pathScore;
-            chosenPath = path;
-            chosenPathPoint = closestPointIndex;
-            chosenPathReverse = reverse;
-            // chosenPathIndex = index;
-        }
     }
 
-    if (!chosenPath)
+    // objective's waypoint can't be reached from here
+    if (!chosenPath || chosenPathScore == FLT_MAX)
         return false;
 
-    // LOG_INFO("playerbots", "{} bot={} path={}", (bot->GetTeamId() == TEAM_HORDE ? "HORDE" : "ALLIANCE"),
-    // bot->GetName(), chosenPathIndex);
-
     return moveToObjectiveWp(chosenPath, chosenPathPoint, chosenPathReverse);
 }
 
+int32 BGTactics::getObjectiveWp(BattleBotWaypointGraph const* graph, PositionInfo const& pos)
+{
+    if (graph != objectiveWpGraph || objectiveWpPos.GetExactDist(pos.x, pos.y, pos.z) > 0.1f)
+    {
+        objectiveWpGraph = graph;
+        objectiveWpPos.Relocate(pos.x, pos.y, pos.z);
+        objectiveWp = graph->GetNearestNode(pos.x, pos.y, pos.z, FLT_MAX);
+    }
+
+    return objectiveWp;
+}
+
 bool BGTactics::resetObjective()
 {
     Battleground* bg = bot->GetBattleground();
     if (!bg)
         return false;
 
-    // Adjust role-change chance based on battleground type
-    uint32 oddsToChangeRole = 1;  // default low
-    BattlegroundTypeId bgType = bg->GetBgTypeID();
-
-    if (bgType == BATTLEGROUND_WS)
-        oddsToChangeRole = 2;
-    else if (bgType == BATTLEGROUND_EY || bgType == BATTLEGROUND_IC || bgType == BATTLEGROUND_AB)
-        oddsToChangeRole = 1;
-    else if (bgType == BATTLEGROUND_AV)
-        oddsToChangeRole = 0;
-
-    bool isCarryingFlag =
-        bot->HasAura(BG_WS_SPELL_WARSONG_FLAG) ||
-        bot->HasAura(BG_WS_SPELL_SILVERWING_FLAG) ||
-        bot->HasAura(BG_EY_NETHERSTORM_FLAG_SPELL);
-
-    // Change role if allowed by odds and not carrying flag
-    if (urand(0, 99) < oddsToChangeRole && !isCarryingFlag)
-        context->GetValue<uint32>("bg role")->Set(urand(0, 9));
-
     // Reset objective position
     PositionMap& posMap = context->GetValue<PositionMap&>("position")->Get();
     PositionInfo pos = context->GetValue<PositionMap&>("position")->Get()["bg objective"];
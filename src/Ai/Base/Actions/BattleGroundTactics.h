@@ -12,6 +12,7 @@
 class ChatHandler;
 class Battleground;
 class PlayerbotAI;
+class PositionInfo;
 struct Position;
 
 #define SPELL_CAPTURE_BANNER 21651
@@ -102,6 +103,44 @@ extern std::vector<BattleBotPath*> const vPaths_AV;
 extern std::vector<BattleBotPath*> const vPaths_EY;
 extern std::vector<BattleBotPath*> const vPaths_IC;
 
+// The waypoints of one battleground's paths as a graph: neighbours on a path are linked (one way for paths that may
+// not be walked backwards), waypoints of different paths closer than JOIN_DISTANCE are linked both ways, each path's
+// ends are linked to the nearest waypoint of every other path within END_JOIN_DISTANCE, and a few wider gaps checked
+// by hand are listed explicitly. The walking distance between every pair of waypoints is computed at startup.
+class BattleBotWaypointGraph
+{
+public:
+    struct Node
+    {
+        BattleBotPath* path;
+        uint32 index;
+        bool reverseAllowed;
+    };
+
+    static float constexpr JOIN_DISTANCE = 10.0f;
+    static float constexpr END_JOIN_DISTANCE = 3 * JOIN_DISTANCE;
+
+    // Startup only
+    static void BuildAll();
+    static BattleBotWaypointGraph const* Get(std::vector<BattleBotPath*> const& paths);
+
+    // Closest waypoint within maxDistance, -1 when there is none
+    int32 GetNearestNode(float x, float y, float z, float maxDistance) const;
+    float GetDistance(uint32 from, uint32 to) const { return distances[from * nodes.size() + to]; }
+    Node const& GetNode(uint32 node) const { return nodes[node]; }
+    BattleBotWaypoint const& GetWaypoint(uint32 node) const { return (*nodes[node].path)[nodes[node].index]; }
+    std::vector<uint32> const& GetJoined(uint32 node) const { return joined[node]; }
+
+private:
+    void Build(std::vector<BattleBotPath*> const& paths);
+    uint32 CountComponents() const;
+
+    std::vector<Node> nodes;                                   // each path's waypoints are consecutive
+    std::vector<std::vector<std::pair<uint32, float>>> links;  // node -> (node, length)
+    std::vector<std::vector<uint32>> joined;                   // node -> waypoints of other paths it is linked to
+    std::vector<float> distances;                              // from * nodes + to, FLT_MAX when unreachable
+};
+
 class BGTactics : public MovementAction
 {
 public:
@@ -118,6 +157,7 @@ private:
     bool selectObjective(bool reset = false);
     bool moveToObjective(bool ignoreDist);
     bool selectObjectiveWp(std::vector<BattleBotPath*> const& vPaths);
+    int32 getObjectiveWp(BattleBotWaypointGraph const* graph, PositionInfo const& pos);
     bool moveToObjectiveWp(BattleBotPath* const& currentPath, uint32 currentPoint, bool reverse = false);
     bool startNewPathBegin(std::vector<BattleBotPath*> const& vPaths);
     bool startNewPathFree(std::vector<BattleBotPath*> const& vPaths);
@@ -131,6 +171,11 @@ private:
     bool useBuff();
     uint32 getPlayersInArea(TeamId teamId, Position point, float range, bool combat = true);
     bool IsLockedInsideKeep();
+
+    // Waypoint closest to the current objective, kept until the objective moves
+    BattleBotWaypointGraph const* objectiveWpGraph = nullptr;
+    Position objectiveWpPos;
+    int32 objectiveWp = -1;
 };
 
 class ArenaTactics : public MovementAction
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "BattleGroundTeamPlanner.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "BattleGroundTactics.h"
+#include "Battleground.h"
+#include "BattlegroundEY.h"
+#include "BattlegroundWS.h"
+#include "Chat.h"
+#include "ObjectAccessor.h"
+#include "Playerbots.h"
+#include "Timer.h"
+
+BGTeamAssignment BattleGroundTeamPlanner::GetAssignment(Player* bot)
+{
+    ++lookups;
+
+    std::lock_guard<std::mutex> guard(lock);
+    TeamPlan const* plan = GetPlan(bot);
+    if (!plan)
+        return BGTeamAssignment();
+
+    std::unordered_map<ObjectGuid, BGTeamAssignment>::const_iterator itr = plan->assignments.find(bot->GetGUID());
+    return itr != plan->assignments.end() ? itr->second : BGTeamAssignment();
+}
+
+ObjectGuid BattleGroundTeamPlanner::GetFlagCarrier(Player* bot)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    TeamPlan const* plan = GetPlan(bot);
+    return plan ? plan->flagCarrier : ObjectGuid::Empty;
+}
+
+void BattleGroundTeamPlanner::OnBattlegroundEnd(uint32 instanceId)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    plans.erase(GetKey(instanceId, TEAM_ALLIANCE));
+    plans.erase(GetKey(instanceId, TEAM_HORDE));
+}
+
+// Caller holds the lock
+BattleGroundTeamPlanner::TeamPlan const* BattleGroundTeamPlanner::GetPlan(Player* bot)
+{
+    Battleground* bg = bot->GetBattleground();
+    if (!bg)
+        return nullptr;
+
+    TeamId const team = bot->GetTeamId();
+    TeamPlan& plan = plans[GetKey(bg->GetInstanceID(), team)];
+    if (!plan.planTime || getMSTimeDiff(plan.planTime, getMSTime()) >= PLAN_INTERVAL ||
+        plan.assignments.find(bot->GetGUID()) == plan.assignments.end())
+        Plan(bg, team, plan);
+
+    return &plan;
+}
+
+void BattleGroundTeamPlanner::Plan(Battleground* bg, TeamId team, TeamPlan& plan)
+{
+    plan.planTime = std::max(getMSTime(), 1u);
+    plan.defenderRoles = GetDefenderRoles(bg, team);
+    plan.flagCarrier = FindFlagCarrier(bg, team);
+    plan.assignments.clear();
+    ++planned;
+
+    std::vector<Player*> bots;
+    for (auto const& itr : bg->GetPlayers())
+    {
+        Player* player = itr.second;
+        if (player && player->IsInWorld() && player->GetTeamId() == team && GET_PLAYERBOT_AI(player))
+            bots.push_back(player);
+    }
+
+    if (bots.empty())
+        return;
+
+    // Ordered by guid so a bot keeps its role from one plan to the next while the team does not change
+    std::sort(bots.begin(), bots.end(), [](Player* a, Player* b) { return a->GetGUID() < b->GetGUID(); });
+
+    std::vector<Player*> attackers;
+    for (uint32 i = 0; i < bots.size(); ++i)
+    {
+        Player* bot = bots[i];
+        BGTeamAssignment& assignment = plan.assignments[bot->GetGUID()];
+        assignment.role = i * 10 / bots.size();
+        if (bot->GetGUID() == plan.flagCarrier)
+            assignment.task = BG_TASK_CARRY;
+        else if (assignment.role < plan.defenderRoles)
+            assignment.task = BG_TASK_DEFEND;
+        else
+        {
+            assignment.task = BG_TASK_ATTACK;
+            attackers.push_back(bot);
+        }
+
+        // Read by the start positions and the battlegrounds splitting their objectives by role
+        GET_PLAYERBOT_AI(bot)->GetAiObjectContext()->GetValue<uint32>("bg role")->Set(assignment.role);
+    }
+
+    if (plan.flagCarrier.IsEmpty() || attackers.empty())
+        return;
+
+    Player* carrier = ObjectAccessor::GetPlayer(bg->GetBgMap(), plan.flagCarrier);
+    if (!carrier)
+        return;
+
+    uint32 const escorts = std::min<uint32>(attackers.size(), std::max<uint32>(1, bots.size() * ESCORT_SHARE / 10));
+    std::partial_sort(attackers.begin(), attackers.begin() + escorts, attackers.end(),
+                      [carrier](Player* a, Player* b)
+                      { return a->GetExactDistSq(carrier) < b->GetExactDistSq(carrier); });
+
+    for (uint32 i = 0; i < escorts; ++i)
+        plan.assignments[attackers[i]->GetGUID()].task = BG_TASK_ESCORT;
+}
+
+// Share of the team (of 10) the team's strategy keeps back to defend
+uint8 BattleGroundTeamPlanner::GetDefenderRoles(Battleground* bg, TeamId team)
+{
+    BattlegroundTypeId bgType = bg->GetBgTypeID();
+    if (bgType == BATTLEGROUND_RB)
+        bgType = bg->GetBgTypeID(true);
+
+    TeamId const enemyTeam = team == TEAM_ALLIANCE ? TEAM_HORDE : TEAM_ALLIANCE;
+    uint8 const strategy = BGTactics::GetBotStrategyForTeam(bg, team);
+    uint8 const enemyStrategy = BGTactics::GetBotStrategyForTeam(bg, enemyTeam);
+
+    switch (bgType)
+    {
+        case BATTLEGROUND_WS:
+            return enemyStrategy == WS_STRATEGY_DEFENSIVE ? 2 : 3;
+        case BATTLEGROUND_AB:
+            if (enemyStrategy == AB_STRATEGY_DEFENSIVE)
+                return 2;
+            if (strategy == AB_STRATEGY_OFFENSIVE)
+                return 1;
+            if (strategy == AB_STRATEGY_DEFENSIVE)
+                return 6;
+            return 3;
+        case BATTLEGROUND_AV:
+            if (enemyStrategy == AV_STRATEGY_DEFENSIVE)
+                return 0;
+            if (strategy == AV_STRATEGY_OFFENSIVE)
+                return 1;
+            if (strategy == AV_STRATEGY_DEFENSIVE)
+                return 9;
+            return 4;
+        case BATTLEGROUND_EY:
+            if (strategy == EY_STRATEGY_FLAG_FOCUS)
+                return 2;
+            if (strategy == EY_STRATEGY_FRONT_FOCUS || strategy == EY_STRATEGY_BACK_FOCUS)
+                return 3;
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+ObjectGuid BattleGroundTeamPlanner::FindFlagCarrier(Battleground* bg, TeamId team)
+{
+    BattlegroundTypeId bgType = bg->GetBgTypeID();
+    if (bgType == BATTLEGROUND_RB)
+        bgType = bg->GetBgTypeID(true);
+
+    if (bgType == BATTLEGROUND_WS)
+    {
+        // The team's carrier holds the other team's flag
+        TeamId const enemyTeam = team == TEAM_ALLIANCE ? TEAM_HORDE : TEAM_ALLIANCE;
+        return static_cast<BattlegroundWS*>(bg)->GetFlagPickerGUID(enemyTeam);
+    }
+
+    if (bgType == BATTLEGROUND_EY)
+    {
+        ObjectGuid const picker = static_cast<BattlegroundEY*>(bg)->GetFlagPickerGUID();
+        Player* carrier = !picker.IsEmpty() ? ObjectAccessor::GetPlayer(bg->GetBgMap(), picker) : nullptr;
+        return carrier && carrier->GetTeamId() == team ? picker : ObjectGuid::Empty;
+    }
+
+    return ObjectGuid::Empty;
+}
+
+void BattleGroundTeamPlanner::PrintStats(ChatHandler* handler) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    handler->PSendSysMessage("Battleground team plans: {} active, {} planned, {} lookups", plans.size(),
+                             planned.load(), lookups.load());
+
+    for (auto const& itr : plans)
+    {
+        uint32 tasks[BG_TASK_CARRY + 1] = {};
+        for (auto const& assignment : itr.second.assignments)
+            ++tasks[assignment.second.task];
+
+        handler->PSendSysMessage("    instance {} {}: {} bots, {} attack, {} defend, {} escort, {} carry",
+                                 itr.first >> 1, (itr.first & 1) ? "horde" : "alliance",
+                                 itr.second.assignments.size(), tasks[BG_TASK_ATTACK], tasks[BG_TASK_DEFEND],
+                                 tasks[BG_TASK_ESCORT], tasks[BG_TASK_CARRY]);
+    }
+}
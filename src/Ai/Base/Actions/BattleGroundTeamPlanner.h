@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_BATTLEGROUNDTEAMPLANNER_H
+#define _PLAYERBOT_BATTLEGROUNDTEAMPLANNER_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "SharedDefines.h"
+
+class Battleground;
+class ChatHandler;
+class Player;
+
+enum BGTeamTask : uint8
+{
+    BG_TASK_ATTACK = 0,
+    BG_TASK_DEFEND = 1,
+    BG_TASK_ESCORT = 2,  // stay with the team's flag carrier
+    BG_TASK_CARRY = 3,   // the team's flag carrier
+};
+
+struct BGTeamAssignment
+{
+    uint8 role = 0;  // 0 - 9, spread evenly over the team's bots
+    BGTeamTask task = BG_TASK_ATTACK;
+};
+
+// Splits the bots of one battleground team between the objectives. Every PLAN_INTERVAL the first bot asking reads
+// the battleground state for its whole team: roles are spread evenly over the bots (so the strategies' role
+// thresholds become exact quotas), the lowest roles defend and the attackers closest to the team's flag carrier
+// escort it. Bots then look their task up instead of rolling for it on every objective change.
+class BattleGroundTeamPlanner
+{
+public:
+    BattleGroundTeamPlanner() {}
+    virtual ~BattleGroundTeamPlanner() {}
+    static BattleGroundTeamPlanner* instance()
+    {
+        static BattleGroundTeamPlanner instance;
+        return &instance;
+    }
+
+    // Map thread of the battleground; replans the bot's team when its plan is stale or does not know the bot yet
+    BGTeamAssignment GetAssignment(Player* bot);
+    // Flag carrier of the team at the last plan, empty when there is none
+    ObjectGuid GetFlagCarrier(Player* bot);
+
+    void OnBattlegroundEnd(uint32 instanceId);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    static uint32 const PLAN_INTERVAL = 5 * IN_MILLISECONDS;
+    static uint32 const ESCORT_SHARE = 3;  // of 10 bots
+
+    struct TeamPlan
+    {
+        uint32 planTime = 0;
+        uint8 defenderRoles = 0;
+        ObjectGuid flagCarrier;
+        std::unordered_map<ObjectGuid, BGTeamAssignment> assignments;
+    };
+
+    static uint64 GetKey(uint32 instanceId, TeamId team) { return (uint64(instanceId) << 1) | uint64(team); }
+    static uint8 GetDefenderRoles(Battleground* bg, TeamId team);
+    static ObjectGuid FindFlagCarrier(Battleground* bg, TeamId team);
+
+    TeamPlan const* GetPlan(Player* bot);
+    void Plan(Battleground* bg, TeamId team, TeamPlan& plan);
+
+    mutable std::mutex lock;
+    std::unordered_map<uint64, TeamPlan> plans;
+
+    std::atomic<uint64> planned{0};
+    std::atomic<uint64> lookups{0};
+};
+
+#define sBattleGroundTeamPlanner BattleGroundTeamPlanner::instance()
+
+#endif
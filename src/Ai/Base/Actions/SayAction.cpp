@@ -6,7 +6,6 @@
 #include "AiFactory.h"
 #include "SayAction.h"
 
-#include <regex>
 #include <string>
 
 #include "ChannelMgr.h"
@@ -667,7 +666,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                     if (rnd == 2)
                         msg = "fine, i wont talk to you anymore %s";
 
-                    msg = std::regex_replace(msg, std::regex("%s"), name);
+                    PlayerbotTextMgr::replaceAll(msg, "%s", name);
                     respondsText = msg;
                     found = true;
                     break;
@@ -706,7 +705,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 break;
             }
 
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -735,7 +734,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 break;
             }
 
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -770,7 +769,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 break;
             }
 
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -805,7 +804,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 break;
             }
 
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -839,7 +838,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 msg = "dunno %s";
                 break;
             }
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -868,7 +867,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                     msg = "afraid that was before i was around or paying attention";
                     break;
                 }
-                msg = std::regex_replace(msg, std::regex("%s"), name);
+                PlayerbotTextMgr::replaceAll(msg, "%s", name);
                 respondsText = msg;
                 found = true;
                 break;
@@ -902,7 +901,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                     msg = "no";
                     break;
                 }
-                msg = std::regex_replace(msg, std::regex("%s"), name);
+                PlayerbotTextMgr::replaceAll(msg, "%s", name);
                 respondsText = msg;
                 found = true;
                 break;
@@ -942,7 +941,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                     msg = "maybe";
                     break;
                 }
-                msg = std::regex_replace(msg, std::regex("%s"), name);
+                PlayerbotTextMgr::replaceAll(msg, "%s", name);
                 respondsText = msg;
                 found = true;
                 break;
@@ -972,7 +971,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 msg = word[verb_pos ? verb_pos - 1 : verb_pos + 1] + " will " + word[verb_pos + 1] + " again though %s";
                 break;
             }
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -994,7 +993,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 msg = "yeah i know " + word[verb_pos ? verb_pos - 1 : verb_pos + 1] + " is a " + word[verb_pos + 1];
                 break;
             }
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -1016,7 +1015,7 @@ std::string ChatReplyAction::GenerateReplyMessage(Player* bot, std::string& inco
                 msg = "are you saying " + word[verb_pos ? verb_pos - 1 : verb_pos + 1] + " will " + word[verb_pos + 1] + " " + word[verb_pos + 2] + " %s?";
                 break;
             }
-            msg = std::regex_replace(msg, std::regex("%s"), name);
+            PlayerbotTextMgr::replaceAll(msg, "%s", name);
             respondsText = msg;
             found = true;
             break;
@@ -6,6 +6,9 @@
 #ifndef _PLAYERBOT_SHAREDVALUECONTEXT_H
 #define _PLAYERBOT_SHAREDVALUECONTEXT_H
 
+#include <memory>
+#include <mutex>
+
 #include "LootValues.h"
 #include "NamedObjectContext.h"
 #include "Playerbots.h"
@@ -17,24 +20,25 @@ class PlayerbotAI;
 class SharedValueContext : public NamedObjectContext<UntypedValue>
 {
 public:
-    SharedValueContext() : NamedObjectContext(true)
+    SharedValueContext() : NamedObjectContext(true), globalAI(new PlayerbotAI())
     {
         creators["bg masters"] = &SharedValueContext::bg_masters;
-        creators["drop map"] = &SharedValueContext::drop_map;
-        creators["item drop list"] = &SharedValueContext::item_drop_list;
-        creators["entry loot list"] = &SharedValueContext::entry_loot_list;
-
         creators["entry quest relation"] = &SharedValueContext::entry_quest_relation;
         creators["quest guidp map"] = &SharedValueContext::quest_guidp_map;
         creators["quest givers"] = &SharedValueContext::quest_givers;
     }
 
+    ~SharedValueContext()
+    {
+        for (GlobalValueShard& shard : shards)
+            for (auto const& entry : shard.entries)
+                delete entry.second->value;
+
+        delete globalAI;
+    }
+
 private:
     static UntypedValue* bg_masters(PlayerbotAI* botAI) { return new BgMastersValue(botAI); }
-    static UntypedValue* drop_map(PlayerbotAI* botAI) { return new DropMapValue(botAI); }
-    static UntypedValue* item_drop_list(PlayerbotAI* botAI) { return new ItemDropListValue(botAI); }
-    static UntypedValue* entry_loot_list(PlayerbotAI* botAI) { return new EntryLootListValue(botAI); }
-
     static UntypedValue* entry_quest_relation(PlayerbotAI* botAI) { return new EntryQuestRelationMapValue(botAI); }
     static UntypedValue* quest_guidp_map(PlayerbotAI* botAI) { return new QuestGuidpMapValue(botAI); }
     static UntypedValue* quest_givers(PlayerbotAI* botAI) { return new QuestGiversValue(botAI); }
@@ -47,18 +51,31 @@ public:
         return &instance;
     }
 
+    // Safe to call from all map update threads. Each key is created and calculated exactly once, later reads are
+    // served from a per-thread cache without taking any lock. Global values are all SingleCalculatedValue, so once
+    // calculated they are only ever read.
     template <class T>
     Value<T>* getGlobalValue(std::string const name)
     {
-        // should never reach here
-        SharedNamedObjectContextList<UntypedValue> sValueContexts;
-        sValueContexts.Add(this);
-        NamedObjectContextList<UntypedValue> valueContexts(sValueContexts);
-        PlayerbotAI* botAI = new PlayerbotAI();
-
-        UntypedValue* value = valueContexts.GetContextObject(name, botAI);
-        delete botAI;
-        return dynamic_cast<Value<T>*>(value);
+        std::unordered_map<std::string, UntypedValue*>& cache = GetThreadCache();
+        std::unordered_map<std::string, UntypedValue*>::const_iterator cached = cache.find(name);
+        if (cached != cache.end())
+            return dynamic_cast<Value<T>*>(cached->second);
+
+        GlobalValueEntry& entry = GetEntry(name);
+        std::call_once(entry.once,
+                       [&]()
+                       {
+                           UntypedValue* value = NamedObjectFactory<UntypedValue>::create(name, globalAI);
+                           // Calculate before publishing so no two threads ever run Calculate on the same value.
+                           if (Value<T>* typed = dynamic_cast<Value<T>*>(value))
+                               typed->Get();
+
+                           entry.value = value;
+                       });
+
+        cache[name] = entry.value;
+        return dynamic_cast<Value<T>*>(entry.value);
     }
 
     template <class T>
@@ -74,6 +91,44 @@ public:
         out << param;
         return getGlobalValue<T>(name, out.str());
     }
+
+private:
+    struct GlobalValueEntry
+    {
+        std::once_flag once;
+        UntypedValue* value = nullptr;
+    };
+
+    static constexpr uint32 SHARD_COUNT = 16;
+
+    struct GlobalValueShard
+    {
+        std::mutex lock;
+        std::unordered_map<std::string, std::unique_ptr<GlobalValueEntry>> entries;
+    };
+
+    // Entries are never removed, so the returned reference stays valid after the shard lock is released.
+    GlobalValueEntry& GetEntry(std::string const& name)
+    {
+        GlobalValueShard& shard = shards[std::hash<std::string>()(name) % SHARD_COUNT];
+        std::lock_guard<std::mutex> guard(shard.lock);
+
+        std::unique_ptr<GlobalValueEntry>& entry = shard.entries[name];
+        if (!entry)
+            entry = std::make_unique<GlobalValueEntry>();
+
+        return *entry;
+    }
+
+    static std::unordered_map<std::string, UntypedValue*>& GetThreadCache()
+    {
+        thread_local std::unordered_map<std::string, UntypedValue*> cache;
+        return cache;
+    }
+
+    // Placeholder owner for global values, they are not tied to a bot.
+    PlayerbotAI* globalAI;
+    GlobalValueShard shards[SHARD_COUNT];
 };
 
 #define sSharedValueContext SharedValueContext::instance()
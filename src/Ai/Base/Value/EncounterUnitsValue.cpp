@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "EncounterUnitsValue.h"
+
+#include "EncounterUnitRegistry.h"
+#include "Playerbots.h"
+
+GuidVector EncounterUnitsValue::Calculate()
+{
+    return sEncounterUnitRegistry->GetUnits(bot->GetMapId(), bot->GetInstanceId(), atoi(qualifier.c_str()));
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_ENCOUNTERUNITSVALUE_H
+#define _PLAYERBOT_ENCOUNTERUNITSVALUE_H
+
+#include "NamedObjectContext.h"
+#include "Value.h"
+
+class PlayerbotAI;
+
+// Units of the qualifier entry in the bot's instance, for entries an encounter strategy tracks with
+// sEncounterUnitRegistry; alive or dead, at any distance
+class EncounterUnitsValue : public ObjectGuidListCalculatedValue, public Qualified
+{
+public:
+    EncounterUnitsValue(PlayerbotAI* botAI, std::string const name = "encounter units")
+        : ObjectGuidListCalculatedValue(botAI, name)
+    {
+    }
+
+    GuidVector Calculate() override;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "ItemUsageValue.h"
 
 #include "AiFactory.h"
+#include "Chat.h"
 #include "ChatHelper.h"
 #include "GuildTaskMgr.h"
 #include "Item.h"
@@ -14,8 +15,58 @@
 #include "PlayerbotFactory.h"
 #include "Playerbots.h"
 #include "RandomItemMgr.h"
+#include "ReagentSpellIndex.h"
 #include "ServerFacade.h"
 #include "StatsWeightCalculator.h"
+#include "Timer.h"
+
+std::atomic<uint64> ItemUsageValue::queries{0};
+std::atomic<uint64> ItemUsageValue::hits{0};
+
+ItemUsageValue::UsageKey ItemUsageValue::GetUsageKey()
+{
+    UsageKey key;
+    key.botVersion = sPlayerbotStateVersions->Get(bot->GetGUID());
+    key.activeMaster = botAI->HasActivePlayerMaster();
+    key.lootFromItem = AI_VALUE(LootObject, "loot target").guid.IsItem();
+
+    Player* master = botAI->GetMaster();
+    if (master && master != bot && sPlayerbotAIConfig->syncQuestWithPlayer)
+    {
+        key.master = master->GetGUID();
+        key.masterVersion = sPlayerbotStateVersions->Get(key.master);
+    }
+
+    return key;
+}
+
+ItemUsage ItemUsageValue::Get()
+{
+    ++queries;
+
+    UsageKey const key = GetUsageKey();
+    if (lastCheckTime && key == usageKey && getMSTimeDiff(lastCheckTime, getMSTime()) < USAGE_LIFETIME)
+    {
+        ++hits;
+        return value;
+    }
+
+    value = Calculate();
+    usageKey = key;
+    lastCheckTime = std::max(getMSTime(), 1u);
+    return value;
+}
+
+ItemUsage& ItemUsageValue::RefGet()
+{
+    Get();
+    return value;
+}
+
+void ItemUsageValue::PrintStats(ChatHandler* handler)
+{
+    handler->PSendSysMessage("Item usage: {} queries, {} cached", queries.load(), hits.load());
+}
 
 ItemUsage ItemUsageValue::Calculate()
 {
@@ -811,33 +862,7 @@ float ItemUsageValue::BetterStacks(ItemTemplate const* proto, std::string const
 
 std::vector<uint32> ItemUsageValue::SpellsUsingItem(uint32 itemId, Player* bot)
 {
-    std::vector<uint32> retSpells;
-
-    PlayerSpellMap const& spellMap = bot->GetSpellMap();
-
-    for (auto& spell : spellMap)
-    {
-        uint32 spellId = spell.first;
-
-        if (spell.second->State == PLAYERSPELL_REMOVED || !spell.second->Active)
-            continue;
-
-        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
-        if (!spellInfo)
-            continue;
-
-        if (spellInfo->IsPassive())
-            continue;
-
-        if (spellInfo->Effects[EFFECT_0].Effect != SPELL_EFFECT_CREATE_ITEM)
-            continue;
-
-        for (uint8 i = 0; i < MAX_SPELL_REAGENTS; i++)
-            if (spellInfo->ReagentCount[i] > 0 && spellInfo->Reagent[i] == itemId)
-                retSpells.push_back(spellId);
-    }
-
-    return retSpells;
+    return sReagentSpellIndex->GetSpellsUsingItem(bot, itemId);
 }
 
 inline int32 SkillGainChance(uint32 SkillValue, uint32 GrayLevel, uint32 GreenLevel, uint32 YellowLevel)
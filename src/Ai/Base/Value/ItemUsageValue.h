@@ -6,9 +6,13 @@
 #ifndef _PLAYERBOT_ITEMUSAGEVALUE_H
 #define _PLAYERBOT_ITEMUSAGEVALUE_H
 
+#include <atomic>
+
 #include "NamedObjectContext.h"
+#include "PlayerbotStateVersions.h"
 #include "Value.h"
 
+class ChatHandler;
 class Item;
 class Player;
 class PlayerbotAI;
@@ -33,6 +37,9 @@ enum ItemUsage : uint32
     ITEM_USAGE_AMMO = 13
 };
 
+// One value per item and random property. The usage is kept until the bot's (or its master's) inventory, quest log,
+// spells, skills or level changed, see PlayerbotStateVersions, or USAGE_LIFETIME passed for the changes no hook
+// reports.
 class ItemUsageValue : public CalculatedValue<ItemUsage>, public Qualified
 {
 public:
@@ -40,9 +47,38 @@ public:
     {
     }
 
+    ItemUsage Get() override;
+    ItemUsage& RefGet() override;
     ItemUsage Calculate() override;
 
+    static void PrintStats(ChatHandler* handler);
+
 private:
+    static uint32 const USAGE_LIFETIME = 10 * IN_MILLISECONDS;
+
+    struct UsageKey
+    {
+        PlayerStateVersion botVersion;
+        PlayerStateVersion masterVersion;
+        ObjectGuid master;
+        bool activeMaster = false;
+        bool lootFromItem = false;
+
+        bool operator==(UsageKey const& other) const
+        {
+            return botVersion == other.botVersion && masterVersion == other.masterVersion &&
+                   master == other.master && activeMaster == other.activeMaster &&
+                   lootFromItem == other.lootFromItem;
+        }
+    };
+
+    UsageKey GetUsageKey();
+
+    UsageKey usageKey;
+
+    static std::atomic<uint64> queries;
+    static std::atomic<uint64> hits;
+
     ItemUsage QueryItemUsageForEquip(ItemTemplate const* proto, int32 randomPropertyId = 0);
     uint32 GetSmallestBagSize();
     bool IsItemUsefulForQuest(Player* player, ItemTemplate const* proto);
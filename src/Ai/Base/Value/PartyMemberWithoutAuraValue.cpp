@@ -5,6 +5,7 @@
 
 #include "PartyMemberWithoutAuraValue.h"
 
+#include "PlayerbotBuffCoverage.h"
 #include "Playerbots.h"
 
 extern std::vector<std::string> split(std::string const s, char delim);
@@ -36,8 +37,32 @@ private:
     std::vector<std::string> auras;
 };
 
+class PlayerWithoutBuffFamilyPredicate : public FindPlayerPredicate
+{
+public:
+    PlayerWithoutBuffFamilyPredicate(uint64 family) : FindPlayerPredicate(), family(family) {}
+
+public:
+    bool Check(Unit* unit) override
+    {
+        return unit->IsAlive() && !sPlayerbotBuffCoverage->HasFamily(unit, family);
+    }
+
+private:
+    uint64 family;
+};
+
 Unit* PartyMemberWithoutAuraValue::Calculate()
 {
+    if (!family)
+        family = sPlayerbotBuffCoverage->GetFamily(qualifier);
+
+    if (family)
+    {
+        PlayerWithoutBuffFamilyPredicate predicate(family);
+        return FindPartyMember(predicate);
+    }
+
     PlayerWithoutAuraPredicate predicate(botAI, qualifier);
     return FindPartyMember(predicate);
 }
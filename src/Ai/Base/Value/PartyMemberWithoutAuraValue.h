@@ -24,6 +24,9 @@ public:
 
 protected:
     Unit* Calculate() override;
+
+private:
+    uint64 family = 0;  // PlayerbotBuffCoverage bit of the qualifier, 0 until first calculated or when out of bits
 };
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "QuestValues.h"
 
+#include "LootIndex.h"
 #include "MapMgr.h"
 #include "Playerbots.h"
 #include "SharedValueContext.h"
@@ -45,8 +46,8 @@ entryQuestRelationMap EntryQuestRelationMapValue::Calculate()
             // Loot objective
             if (quest->RequiredItemId[objective])
             {
-                for (auto& entry : GAI_VALUE2(std::vector<int32>, "item drop list", quest->RequiredItemId[objective]))
-                    rMap[entry][questId] |= relationFlag;
+                for (LootIndexSource const& source : sLootIndex->GetItemSources(quest->RequiredItemId[objective]))
+                    rMap[source.entry][questId] |= relationFlag;
             }
         }
     }
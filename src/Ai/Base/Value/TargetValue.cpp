@@ -7,6 +7,7 @@
 
 #include "LastMovementValue.h"
 #include "ObjectGuid.h"
+#include "ObjectMgr.h"
 #include "Playerbots.h"
 #include "RtiTargetValue.h"
 #include "ScriptedCreature.h"
@@ -133,6 +134,47 @@ WorldPosition HomeBindValue::Calculate()
     return WorldPosition(bot->m_homebindMapId, bot->m_homebindX, bot->m_homebindY, bot->m_homebindZ, 0.f);
 }
 
+std::unordered_map<std::string, std::vector<uint32>> FindTargetValue::nameIndex;
+
+void FindTargetValue::BuildNameIndex()
+{
+    // Creature templates are not reloaded with the config, and values may be reading the index
+    if (!nameIndex.empty())
+        return;
+
+    CreatureTemplateContainer const* creatures = sObjectMgr->GetCreatureTemplates();
+    for (CreatureTemplateContainer::const_iterator itr = creatures->begin(); itr != creatures->end(); ++itr)
+        nameIndex[ToLower(itr->second.Name)].push_back(itr->first);
+
+    LOG_INFO("server.loading", ">> Indexed {} creature names", nameIndex.size());
+}
+
+std::string const FindTargetValue::ToLower(std::string const& name)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return name;
+
+    wstrToLower(wname);
+
+    std::string lower;
+    WStrToUtf8(wname, lower);
+    return lower;
+}
+
+std::unordered_map<uint32, ObjectGuid> ThreatEntriesValue::Calculate()
+{
+    std::unordered_map<uint32, ObjectGuid> threat;
+    for (HostileReference* ref = bot->getHostileRefMgr().getFirst(); ref; ref = ref->next())
+    {
+        Unit* unit = ref->GetSource()->GetOwner();
+        if (unit->IsCreature())
+            threat.emplace(unit->GetEntry(), unit->GetGUID());
+    }
+
+    return threat;
+}
+
 Unit* FindTargetValue::Calculate()
 {
     if (qualifier == "")
@@ -144,20 +186,35 @@ Unit* FindTargetValue::Calculate()
     {
         return nullptr;
     }
-    HostileReference* ref = bot->getHostileRefMgr().getFirst();
-    while (ref)
+
+    if (resolvedQualifier != qualifier)
     {
-        ThreatMgr* threatManager = ref->GetSource();
-        Unit* unit = threatManager->GetOwner();
-        std::wstring wnamepart;
-        Utf8toWStr(unit->GetName(), wnamepart);
-        wstrToLower(wnamepart);
-        if (!qualifier.empty() && qualifier.length() == wnamepart.length() && Utf8FitTo(qualifier, wnamepart))
-        {
+        std::unordered_map<std::string, std::vector<uint32>>::const_iterator itr = nameIndex.find(ToLower(qualifier));
+        if (itr != nameIndex.end())
+            entries = itr->second;
+        else
+            entries.clear();
+
+        resolvedQualifier = qualifier;
+    }
+
+    if (entries.empty())
+        return nullptr;
+
+    std::unordered_map<uint32, ObjectGuid> const& threat =
+        context->GetValue<std::unordered_map<uint32, ObjectGuid>>("threat entries")->RefGet();
+    for (uint32 entry : entries)
+    {
+        std::unordered_map<uint32, ObjectGuid>::const_iterator itr = threat.find(entry);
+        if (itr == threat.end())
+            continue;
+
+        // The snapshot may be a few updates old
+        Unit* unit = botAI->GetUnit(itr->second);
+        if (unit && unit->IsAlive())
             return unit;
-        }
-        ref = ref->next();
     }
+
     return nullptr;
 }
 
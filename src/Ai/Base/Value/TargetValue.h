@@ -6,6 +6,9 @@
 #ifndef _PLAYERBOT_TARGETVALUE_H
 #define _PLAYERBOT_TARGETVALUE_H
 
+#include <unordered_map>
+#include <vector>
+
 #include "NamedObjectContext.h"
 #include "TravelMgr.h"
 #include "Value.h"
@@ -116,6 +119,17 @@ public:
     }
 };
 
+// First unit of each creature entry that has the bot on its threat list, shared by all "find target" qualifiers
+class ThreatEntriesValue : public CalculatedValue<std::unordered_map<uint32, ObjectGuid>>
+{
+public:
+    ThreatEntriesValue(PlayerbotAI* ai) : CalculatedValue(ai, "threat entries", 100) {}  // ms
+
+protected:
+    std::unordered_map<uint32, ObjectGuid> Calculate() override;
+};
+
+// Qualifier is a creature name (any case), resolved once to the creature entries having that name
 class FindTargetValue : public UnitCalculatedValue, public Qualified
 {
 public:
@@ -123,6 +137,17 @@ public:
 
 public:
     Unit* Calculate();
+
+    // Lowercase creature template name -> entries, built once at startup
+    static void BuildNameIndex();
+
+private:
+    static std::string const ToLower(std::string const& name);
+
+    static std::unordered_map<std::string, std::vector<uint32>> nameIndex;
+
+    std::string resolvedQualifier;
+    std::vector<uint32> entries;  // copied, so the value never points into the index
 };
 
 class FindBossTargetStrategy : public FindTargetStrategy
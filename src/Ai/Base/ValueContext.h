@@ -24,6 +24,7 @@
 #include "DistanceValue.h"
 #include "DpsTargetValue.h"
 #include "DuelTargetValue.h"
+#include "EncounterUnitsValue.h"
 #include "EnemyHealerTargetValue.h"
 #include "EnemyPlayerValue.h"
 #include "EstimatedLifetimeValue.h"
@@ -106,6 +107,7 @@ public:
         creators["closest game objects"] = &ValueContext::closest_game_objects;
         creators["nearest npcs"] = &ValueContext::nearest_npcs;
         creators["nearest hostile npcs"] = &ValueContext::nearest_hostile_npcs;
+        creators["encounter units"] = &ValueContext::encounter_units;
         creators["nearest totems"] = &ValueContext::nearest_totems;
         creators["nearest vehicles"] = &ValueContext::nearest_vehicles;
         creators["nearest vehicles far"] = &ValueContext::nearest_vehicles_far;
@@ -302,6 +304,7 @@ public:
 
         creators["main tank"] = &ValueContext::main_tank;
         creators["find target"] = &ValueContext::find_target;
+        creators["threat entries"] = &ValueContext::threat_entries;
         creators["boss target"] = &ValueContext::boss_target;
         creators["nearest triggers"] = &ValueContext::nearest_triggers;
         creators["neglect threat"] = &ValueContext::neglect_threat;
@@ -549,6 +552,8 @@ private:
 
     static UntypedValue* main_tank(PlayerbotAI* ai) { return new PartyMemberMainTankValue(ai); }
     static UntypedValue* find_target(PlayerbotAI* ai) { return new FindTargetValue(ai); }
+    static UntypedValue* threat_entries(PlayerbotAI* ai) { return new ThreatEntriesValue(ai); }
+    static UntypedValue* encounter_units(PlayerbotAI* ai) { return new EncounterUnitsValue(ai); }
     static UntypedValue* boss_target(PlayerbotAI* ai) { return new BossTargetValue(ai); }
     static UntypedValue* nearest_triggers(PlayerbotAI* ai) { return new NearestTriggersValue(ai); }
     static UntypedValue* neglect_threat(PlayerbotAI* ai) { return new NeglectThreatResetValue(ai); }
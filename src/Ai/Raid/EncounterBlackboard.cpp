@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "EncounterBlackboard.h"
+
+#include "Chat.h"
+#include "Creature.h"
+#include "Map.h"
+#include "MapMgr.h"
+
+EncounterBlackboard* EncounterBlackboardMgr::Get(Unit* boss)
+{
+    if (!boss || !boss->IsInWorld() || !boss->IsAlive() || !boss->IsInCombat())
+        return nullptr;
+
+    uint64 const key = GetKey(boss->GetInstanceId(), boss->GetEntry());
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::unique_ptr<EncounterBlackboard>& board = boards[key];
+    if (board && board->GetBossGuid() == boss->GetGUID())
+        return board.get();
+
+    // First pull, or the boss respawned with a new guid before the sweep noticed
+    if (board)
+        ++destroyed;
+
+    board = std::make_unique<EncounterBlackboard>(boss->GetGUID(), boss->GetMapId(), boss->GetInstanceId());
+    ++created;
+    return board.get();
+}
+
+void EncounterBlackboardMgr::Update(uint32 diff)
+{
+    sweepTimer += diff;
+    if (sweepTimer < SWEEP_INTERVAL)
+        return;
+
+    sweepTimer = 0;
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto itr = boards.begin(); itr != boards.end();)
+    {
+        EncounterBlackboard const* board = itr->second.get();
+        Map* map = sMapMgr->FindMap(board->GetMapId(), board->GetInstanceId());
+        Creature* boss = map ? map->GetCreature(board->GetBossGuid()) : nullptr;
+        if (boss && boss->IsAlive() && boss->IsInCombat())
+        {
+            ++itr;
+            continue;
+        }
+
+        itr = boards.erase(itr);
+        ++destroyed;
+    }
+}
+
+void EncounterBlackboardMgr::PrintStats(ChatHandler* handler) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    handler->PSendSysMessage("Encounter blackboards: {} active, {} created, {} destroyed", boards.size(),
+                             created.load(), destroyed.load());
+
+    for (auto const& itr : boards)
+        handler->PSendSysMessage("    map {} instance {} boss {}: {} slots", itr.second->GetMapId(),
+                                 itr.second->GetInstanceId(), itr.second->GetBossGuid().ToString(),
+                                 itr.second->GetSlotCount());
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_ENCOUNTERBLACKBOARD_H
+#define _PLAYERBOT_ENCOUNTERBLACKBOARD_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+class Unit;
+
+// State shared by the bots fighting one boss in one instance (positions handed out, timers, assignments). Every
+// bot of an instance updates on the same map thread, so a board is only written by that thread and needs no lock.
+class EncounterBlackboard
+{
+public:
+    EncounterBlackboard(ObjectGuid bossGuid, uint32 mapId, uint32 instanceId)
+        : bossGuid(bossGuid), mapId(mapId), instanceId(instanceId)
+    {
+    }
+
+    // Named slot, value initialized on first use for this engagement
+    template <class T>
+    T& Get(std::string const& name)
+    {
+        std::unique_ptr<SlotBase>& slot = slots[name];
+        Slot<T>* typed = dynamic_cast<Slot<T>*>(slot.get());
+        if (!typed)
+        {
+            typed = new Slot<T>();
+            slot.reset(typed);
+        }
+
+        return typed->value;
+    }
+
+    void Erase(std::string const& name) { slots.erase(name); }
+
+    ObjectGuid GetBossGuid() const { return bossGuid; }
+    uint32 GetMapId() const { return mapId; }
+    uint32 GetInstanceId() const { return instanceId; }
+    uint32 GetSlotCount() const { return slots.size(); }
+
+private:
+    struct SlotBase
+    {
+        virtual ~SlotBase() {}
+    };
+
+    template <class T>
+    struct Slot : SlotBase
+    {
+        T value{};
+    };
+
+    ObjectGuid bossGuid;
+    uint32 mapId;
+    uint32 instanceId;
+    std::unordered_map<std::string, std::unique_ptr<SlotBase>> slots;
+};
+
+// Boards per instance and boss entry. A board is created by the first bot asking for it while the boss is in
+// combat and dropped by Update once the boss died, evaded or the instance is gone, so the next pull starts clean.
+class EncounterBlackboardMgr
+{
+public:
+    EncounterBlackboardMgr() {}
+    virtual ~EncounterBlackboardMgr() {}
+    static EncounterBlackboardMgr* instance()
+    {
+        static EncounterBlackboardMgr instance;
+        return &instance;
+    }
+
+    // Map thread of the boss; nullptr when the boss is missing, dead or not engaged
+    EncounterBlackboard* Get(Unit* boss);
+    // World thread only, while the maps are idle
+    void Update(uint32 diff);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    static uint32 const SWEEP_INTERVAL = 1 * IN_MILLISECONDS;
+
+    static uint64 GetKey(uint32 instanceId, uint32 bossEntry) { return (uint64(instanceId) << 32) | bossEntry; }
+
+    mutable std::mutex lock;
+    std::unordered_map<uint64, std::unique_ptr<EncounterBlackboard>> boards;
+    uint32 sweepTimer = 0;
+
+    std::atomic<uint64> created{0};
+    std::atomic<uint64> destroyed{0};
+};
+
+#define sEncounterBlackboardMgr EncounterBlackboardMgr::instance()
+
+#endif
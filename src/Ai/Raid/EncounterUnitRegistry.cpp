@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "EncounterUnitRegistry.h"
+
+#include <algorithm>
+
+#include "Chat.h"
+#include "Creature.h"
+
+void EncounterUnitRegistry::Track(uint32 mapId, std::vector<uint32> const& entries)
+{
+    tracked[mapId].insert(entries.begin(), entries.end());
+}
+
+bool EncounterUnitRegistry::IsTracked(uint32 mapId, uint32 entry) const
+{
+    std::unordered_map<uint32, std::unordered_set<uint32>>::const_iterator itr = tracked.find(mapId);
+    return itr != tracked.end() && itr->second.find(entry) != itr->second.end();
+}
+
+void EncounterUnitRegistry::OnAddToWorld(Creature* creature)
+{
+    if (!IsTracked(creature->GetMapId(), creature->GetEntry()))
+        return;
+
+    uint64 const key = GetKey(creature->GetMapId(), creature->GetInstanceId());
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.instances[key][creature->GetEntry()].push_back(creature->GetGUID());
+    ++added;
+}
+
+void EncounterUnitRegistry::OnRemoveFromWorld(Creature* creature)
+{
+    if (!IsTracked(creature->GetMapId(), creature->GetEntry()))
+        return;
+
+    uint64 const key = GetKey(creature->GetMapId(), creature->GetInstanceId());
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    std::unordered_map<uint64, InstanceUnits>::iterator instance = shard.instances.find(key);
+    if (instance == shard.instances.end())
+        return;
+
+    InstanceUnits::iterator units = instance->second.find(creature->GetEntry());
+    if (units == instance->second.end())
+        return;
+
+    GuidVector& guids = units->second;
+    GuidVector::iterator itr = std::find(guids.begin(), guids.end(), creature->GetGUID());
+    if (itr == guids.end())
+        return;
+
+    *itr = guids.back();
+    guids.pop_back();
+    ++removed;
+
+    if (guids.empty())
+        instance->second.erase(units);
+
+    if (instance->second.empty())
+        shard.instances.erase(instance);
+}
+
+GuidVector EncounterUnitRegistry::GetUnits(uint32 mapId, uint32 instanceId, uint32 entry) const
+{
+    ++queries;
+
+    uint64 const key = GetKey(mapId, instanceId);
+    Shard const& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    std::unordered_map<uint64, InstanceUnits>::const_iterator instance = shard.instances.find(key);
+    if (instance == shard.instances.end())
+        return GuidVector();
+
+    InstanceUnits::const_iterator units = instance->second.find(entry);
+    if (units == instance->second.end())
+        return GuidVector();
+
+    return units->second;
+}
+
+void EncounterUnitRegistry::PrintStats(ChatHandler* handler) const
+{
+    uint32 entries = 0;
+    for (auto const& itr : tracked)
+        entries += itr.second.size();
+
+    uint32 instances = 0;
+    uint32 units = 0;
+    for (Shard const& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        instances += shard.instances.size();
+        for (auto const& instance : shard.instances)
+            for (auto const& itr : instance.second)
+                units += itr.second.size();
+    }
+
+    handler->PSendSysMessage("Encounter units: {} entries tracked on {} maps", entries, tracked.size());
+    handler->PSendSysMessage("    {} units in {} instances, {} added, {} removed, {} queries", units, instances,
+                             added.load(), removed.load(), queries.load());
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_ENCOUNTERUNITREGISTRY_H
+#define _PLAYERBOT_ENCOUNTERUNITREGISTRY_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+class Creature;
+
+// Creatures of the entries the encounter strategies track, per instance, kept up to date from the creature add and
+// remove world hooks. Boss mechanics ask for "units of entry X" here instead of filtering the nearest npcs list of
+// every bot on every tick.
+class EncounterUnitRegistry
+{
+public:
+    EncounterUnitRegistry() {}
+    virtual ~EncounterUnitRegistry() {}
+    static EncounterUnitRegistry* instance()
+    {
+        static EncounterUnitRegistry instance;
+        return &instance;
+    }
+
+    // Startup only, before any map is created
+    void Track(uint32 mapId, std::vector<uint32> const& entries);
+
+    // Map thread of the creature
+    void OnAddToWorld(Creature* creature);
+    void OnRemoveFromWorld(Creature* creature);
+
+    // Map thread of the instance; dead units are still listed until their corpse leaves the world
+    GuidVector GetUnits(uint32 mapId, uint32 instanceId, uint32 entry) const;
+    bool IsTracked(uint32 mapId, uint32 entry) const;
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    static uint32 const SHARD_COUNT = 16;
+
+    typedef std::unordered_map<uint32, GuidVector> InstanceUnits;  // entry -> units
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<uint64, InstanceUnits> instances;
+    };
+
+    static uint64 GetKey(uint32 mapId, uint32 instanceId) { return (uint64(mapId) << 32) | instanceId; }
+    Shard& GetShard(uint64 key) { return shards[key % SHARD_COUNT]; }
+    Shard const& GetShard(uint64 key) const { return shards[key % SHARD_COUNT]; }
+
+    std::unordered_map<uint32, std::unordered_set<uint32>> tracked;  // map id -> entries
+    Shard shards[SHARD_COUNT];
+
+    mutable std::atomic<uint64> queries{0};
+    std::atomic<uint64> added{0};
+    std::atomic<uint64> removed{0};
+};
+
+#define sEncounterUnitRegistry EncounterUnitRegistry::instance()
+
+#endif
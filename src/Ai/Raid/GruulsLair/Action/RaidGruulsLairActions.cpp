@@ -1,6 +1,7 @@
 #include "RaidGruulsLairActions.h"
 #include "RaidGruulsLairHelpers.h"
 #include "CreatureAI.h"
+#include "EncounterBlackboard.h"
 #include "Playerbots.h"
 #include "Unit.h"
 
@@ -575,15 +576,14 @@ bool GruulTheDragonkillerSpreadRangedAction::Execute(Event event)
     if (!group)
         return false;
 
-    static std::unordered_map<ObjectGuid, Position> initialPositions;
-    static std::unordered_map<ObjectGuid, bool> hasReachedInitialPosition;
-
+    // Positions are handed out once per pull, the board is dropped on wipe or kill
     Unit* gruul = AI_VALUE2(Unit*, "find target", "gruul the dragonkiller");
-    if (gruul && gruul->IsAlive() && gruul->GetHealth() == gruul->GetMaxHealth())
-    {
-        initialPositions.clear();
-        hasReachedInitialPosition.clear();
-    }
+    EncounterBlackboard* board = context->GetEncounterBlackboard(gruul);
+    if (!board)
+        return false;
+
+    auto& initialPositions = board->Get<std::unordered_map<ObjectGuid, Position>>("ranged initial positions");
+    auto& hasReachedInitialPosition = board->Get<std::unordered_map<ObjectGuid, bool>>("ranged reached position");
 
     const Location& tankPosition = GruulsLairLocations::GruulTankPosition;
     const float centerX = tankPosition.x;
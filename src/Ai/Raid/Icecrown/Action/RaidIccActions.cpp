@@ -1,4 +1,5 @@
 #include "RaidIccActions.h"
+#include "EncounterBlackboard.h"
 #include "NearestNpcsValue.h"
 #include "ObjectAccessor.h"
 #include "RaidIccStrategy.h"
@@ -339,7 +340,7 @@ bool IccAddsLadyDeathwhisperAction::Execute(Event event)
 
 bool IccAddsLadyDeathwhisperAction::IsTargetedByShade(uint32 shadeEntry)
 {
-    const GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    const GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", shadeEntry);
     for (auto const& npcGuid : npcs)
     {
         Unit* unit = botAI->GetUnit(npcGuid);
@@ -424,8 +425,8 @@ bool IccShadeLadyDeathwhisperAction::Execute(Event event)
     static constexpr uint32 VENGEFUL_SHADE_ID = NPC_SHADE;
     static constexpr float SAFE_DISTANCE = 12.0f;
 
-    // Get the nearest hostile NPCs
-    const GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    // Get the vengeful shades
+    const GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", VENGEFUL_SHADE_ID);
 
     for (auto const& npcGuid : npcs)
     {
@@ -1703,7 +1704,7 @@ bool IccRotfaceTankPositionAction::HandleAssistTankPositioning(Unit* boss)
 bool IccRotfaceTankPositionAction::HandleBigOozePositioning(Unit* boss)
 {
     // Find all big oozes
-    GuidVector bigOozes = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector bigOozes = AI_VALUE2(GuidVector, "encounter units", NPC_BIG_OOZE);
     std::vector<Unit*> activeBigOozes;
 
     for (auto const& guid : bigOozes)
@@ -2275,7 +2276,7 @@ Unit* IccPutricideGrowingOozePuddleAction::FindClosestThreateningPuddle()
     static const float STACK_MULTIPLIER = 0.6f;
     static const float MIN_DISTANCE = 0.1f;
 
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_GROWING_OOZE_PUDDLE);
     if (npcs.empty())
         return nullptr;
 
@@ -2397,7 +2398,7 @@ bool IccPutricideGrowingOozePuddleAction::IsPositionTooCloseToOtherPuddles(float
     static const float BASE_RADIUS = 2.0f;
     static const float STACK_MULTIPLIER = 0.6f;
 
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_GROWING_OOZE_PUDDLE);
     for (auto const& npc : npcs)
     {
         Unit* unit = botAI->GetUnit(npc);
@@ -2606,7 +2607,7 @@ bool IccPutricideGasCloudAction::HandleGaseousBloatMovement(Unit* gasCloud)
         return false;
 
     // Gather all choking gas bombs
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_CHOKING_GAS_BOMB);
     std::vector<Unit*> gasBombs;
     for (auto const& guid : npcs)
     {
@@ -3853,7 +3854,7 @@ bool IccBqlGroupPositionAction::Execute(Event event)
         return true;
 
     // Handle swarming shadows movement
-    if (shadowAura && HandleShadowsMovement())
+    if (shadowAura && HandleShadowsMovement(boss))
         return true;
 
     // Handle group positioning
@@ -3892,7 +3893,7 @@ bool IccBqlGroupPositionAction::HandleTankPosition(Unit* boss, Aura* frenzyAura,
     return false;
 }
 
-bool IccBqlGroupPositionAction::HandleShadowsMovement()
+bool IccBqlGroupPositionAction::HandleShadowsMovement(Unit* boss)
 {
     const float SAFE_SHADOW_DIST = 4.0f;
     const float ARC_STEP = 0.05f;
@@ -3905,8 +3906,11 @@ bool IccBqlGroupPositionAction::HandleShadowsMovement()
     const float DISTANCE_PENALTY_FACTOR = 100.0f;  // Penalty per yard moved from current position
     const float MAX_CURVE_JUMP_DIST = 5.0f;        // Maximum distance for jumping between curves
 
-    // Track current curve to avoid unnecessary switching
-    static std::map<ObjectGuid, int> botCurrentCurve;
+    // Track current curve to avoid unnecessary switching; without a board the bot still dodges, from curve 0
+    std::map<ObjectGuid, int> localCurrentCurve;
+    EncounterBlackboard* board = context->GetEncounterBlackboard(boss);
+    auto& botCurrentCurve =
+        board ? board->Get<std::map<ObjectGuid, int>>("shadows current curve") : localCurrentCurve;
     int currentCurve = botCurrentCurve.count(bot->GetGUID()) ? botCurrentCurve[bot->GetGUID()] : 0;
 
     // Find closest wall path
@@ -3917,7 +3921,7 @@ bool IccBqlGroupPositionAction::HandleShadowsMovement()
     Position* basePath = (bot->GetExactDist2d(lwall[0]) < bot->GetExactDist2d(rwall[0])) ? lwall : rwall;
 
     // Find all swarming shadows
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_SWARMING_SHADOWS);
     Unit* shadows[100]{};  // Reasonable max estimate
     int shadowCount = 0;
     for (int i = 0; i < npcs.size() && shadowCount < 100; i++)
@@ -4449,7 +4453,7 @@ bool IccBqlGroupPositionAction::HandleGroupPosition(Unit* boss, Aura* frenzyAura
                 }
             }
             // Also spread from swarming shadows
-            GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+            GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_SWARMING_SHADOWS);
             for (auto const& npcGuid : npcs)
             {
                 Unit* unit = botAI->GetUnit(npcGuid);
@@ -4530,7 +4534,7 @@ bool IccBqlGroupPositionAction::HandleGroupPosition(Unit* boss, Aura* frenzyAura
         int nearbyCount = 0;
 
         // Find all swarming shadows
-        GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+        GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_SWARMING_SHADOWS);
         std::vector<Unit*> swarmingShadows;
         for (int i = 0; i < npcs.size(); ++i)
         {
@@ -4931,7 +4935,7 @@ bool IccValithriaGroupAction::Execute(Event event)
     Creature* manaVoid = bot->FindNearestCreature(NPC_MANA_VOID, 100.0f);
 
     // Find column of frost units
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_COLUMN_OF_FROST);
     std::vector<Unit*> columnOfFrost;
     for (ObjectGuid guid : npcs)
     {
@@ -6566,9 +6570,16 @@ bool IccSindragosaFrostBombAction::Execute(Event event)
         return true;
     }
 
-    // Get persistent group assignment - use a static map to store assignments
-    static std::map<ObjectGuid, int> persistentGroupAssignments;
-    static std::vector<ObjectGuid> allGroupGuids;  // All guids that have ever been in the raid
+    // Get persistent group assignment, kept on the encounter board for the whole pull. Sindragosa is found the way
+    // the trigger finds her; without a board the assignment is computed from the current group for this call only
+    std::map<ObjectGuid, int> localGroupAssignments;
+    std::vector<ObjectGuid> localGroupGuids;
+    EncounterBlackboard* board = context->GetEncounterBlackboard(bot->FindNearestCreature(NPC_SINDRAGOSA, 200.0f));
+
+    auto& persistentGroupAssignments =
+        board ? board->Get<std::map<ObjectGuid, int>>("frost bomb group assignments") : localGroupAssignments;
+    auto& allGroupGuids =
+        board ? board->Get<std::vector<ObjectGuid>>("frost bomb group guids") : localGroupGuids;  // ever in the raid
 
     // Gather all group members (alive and dead, including those with ice tomb)
     std::vector<ObjectGuid> currentGuids;
@@ -6837,7 +6848,7 @@ bool IccLichKingShadowTrapAction::Execute(Event event)
     const float ANGLE_STEP = 2 * M_PI / TEST_POSITIONS;
 
     // Find all nearby shadow traps
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_SHADOW_TRAP);
     std::vector<ObjectGuid> trapGuids;
     for (auto& npc : npcs)
     {
@@ -7202,7 +7213,7 @@ bool IccLichKingWinterAction::IsPositionSafeFromDefile(float x, float y, float z
     if (!boss)
         return true;  // No boss, assume safe
 
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", DEFILE_NPC_ID);
     const float BASE_RADIUS = 6.0f;
     const float SAFETY_MARGIN = 3.0f;
 
@@ -7947,7 +7958,7 @@ bool IccLichKingAddsAction::HandleSpiritBombAvoidance(Difficulty diff, Unit* ter
     std::map<ObjectGuid, Unit*> spiritBombs;
 
     // Gather all spirit bombs using their GUIDs for reliable tracking
-    GuidVector npcs1 = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs1 = AI_VALUE2(GuidVector, "encounter units", NPC_SPIRIT_BOMB);
     for (auto& npcGuid : npcs1)
     {
         Unit* unit = botAI->GetUnit(npcGuid);
@@ -8726,7 +8737,7 @@ void IccLichKingAddsAction::HandleDefileMechanics(Unit* boss, Difficulty diff)
     Unit* closestDefile = nullptr;
     float closestDistance = std::numeric_limits<float>::max();
 
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", DEFILE_NPC_ID);
     for (auto& npc : npcs)
     {
         Unit* unit = botAI->GetUnit(npc);
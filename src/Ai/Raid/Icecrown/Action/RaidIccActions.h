@@ -414,7 +414,7 @@ public:
     bool Execute(Event event) override;
 
     bool HandleTankPosition(Unit* boss, Aura* frenzyAura, Aura* shadowAura);
-    bool HandleShadowsMovement();
+    bool HandleShadowsMovement(Unit* boss);
     Position AdjustControlPoint(const Position& wall, const Position& center, float factor);
     Position CalculateBezierPoint(float t, const Position path[4]);
     bool HandleGroupPosition(Unit* boss, Aura* frenzyAura, Aura* shadowAura);
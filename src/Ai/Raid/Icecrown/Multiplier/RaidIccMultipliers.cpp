@@ -4,6 +4,7 @@
 #include "DKActions.h"
 #include "DruidActions.h"
 #include "DruidBearActions.h"
+#include "EncounterBlackboard.h"
 #include "FollowActions.h"
 #include "GenericActions.h"
 #include "GenericSpellActions.h"
@@ -22,16 +23,6 @@
 #include "PlayerbotAI.h"
 #include "RaidIccTriggers.h"
 
-// LK global variables
-namespace
-{
-uint32 g_lastPlagueTime = 0;
-bool g_plagueAllowedToCure = false;
-std::map<ObjectGuid, uint32> g_plagueTimes;
-std::map<ObjectGuid, bool> g_allowCure;
-std::mutex g_plagueMutex;  // Lock before accessing shared variables
-}
-
 // Lady Deathwhisper
 float IccLadyDeathwhisperMultiplier::GetValue(Action* action)
 {
@@ -44,8 +35,8 @@ float IccLadyDeathwhisperMultiplier::GetValue(Action* action)
 
     static constexpr uint32 VENGEFUL_SHADE_ID = NPC_SHADE;
 
-    // Get the nearest hostile NPCs
-    const GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    // Get the vengeful shades
+    const GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", VENGEFUL_SHADE_ID);
 
     // Allow the IccShadeLadyDeathwhisperAction to run
     if (dynamic_cast<IccShadeLadyDeathwhisperAction*>(action))
@@ -182,8 +173,12 @@ float IccRotfaceMultiplier::GetValue(Action* action)
     if (!boss)
         return 1.0f;
 
-    static std::map<ObjectGuid, uint32> lastExplosionTimes;
-    static std::map<ObjectGuid, bool> hasMoved;
+    EncounterBlackboard* board = context->GetEncounterBlackboard(boss);
+    if (!board)
+        return 1.0f;
+
+    auto& lastExplosionTimes = board->Get<std::map<ObjectGuid, uint32>>("explosion times");
+    auto& hasMoved = board->Get<std::map<ObjectGuid, bool>>("explosion moved");
 
     ObjectGuid botGuid = bot->GetGUID();
 
@@ -722,39 +717,41 @@ float IccLichKingAddsMultiplier::GetValue(Action* action)
 
         uint32 currentTime = getMSTime();
 
+        EncounterBlackboard* board = context->GetEncounterBlackboard(boss);
+        if (!board)
+            return 1.0f;
+
+        auto& plagueTimes = board->Get<std::map<ObjectGuid, uint32>>("plague times");
+        auto& allowCure = board->Get<std::map<ObjectGuid, bool>>("plague allow cure");
+
         // Reset state if no one has plague
         if (!anyBotHasPlague)
         {
-            std::lock_guard<std::mutex> lock(g_plagueMutex);  // Properly initialized
-            g_plagueTimes.clear();
-            g_allowCure.clear();
+            plagueTimes.clear();
+            allowCure.clear();
             return 1.0f;
         }
 
-        {                                                     // New scope for lock_guard
-            std::lock_guard<std::mutex> lock(g_plagueMutex);  // Properly initialized
-
-            // Start timer if this is a new plague
-            if (g_plagueTimes.find(plaguedPlayerGuid) == g_plagueTimes.end())
-            {
-                g_plagueTimes[plaguedPlayerGuid] = currentTime;
-                g_allowCure[plaguedPlayerGuid] = false;
-                return 0.0f;
-            }
+        // Start timer if this is a new plague
+        if (plagueTimes.find(plaguedPlayerGuid) == plagueTimes.end())
+        {
+            plagueTimes[plaguedPlayerGuid] = currentTime;
+            allowCure[plaguedPlayerGuid] = false;
+            return 0.0f;
+        }
 
-            // Once we allow cure, keep allowing it until plague is gone
-            if (g_allowCure[plaguedPlayerGuid])
-            {
-                return 1.0f;
-            }
+        // Once we allow cure, keep allowing it until plague is gone
+        if (allowCure[plaguedPlayerGuid])
+        {
+            return 1.0f;
+        }
 
-            // Check if enough time has passed (2,5 seconds)
-            if (currentTime - g_plagueTimes[plaguedPlayerGuid] >= 2500)
-            {
-                g_allowCure[plaguedPlayerGuid] = true;
-                return 1.0f;
-            }
-        }  // lock_guard is automatically released here
+        // Check if enough time has passed (2,5 seconds)
+        if (currentTime - plagueTimes[plaguedPlayerGuid] >= 2500)
+        {
+            allowCure[plaguedPlayerGuid] = true;
+            return 1.0f;
+        }
 
         return 0.0f;
     }
@@ -841,7 +838,7 @@ float IccLichKingAddsMultiplier::GetValue(Action* action)
     if (botAI->IsRanged(bot) && !botAI->GetAura("Harvest Soul", bot, false, false))
     {
         // Check for defile presence
-        GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+        GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", DEFILE_NPC_ID);
         bool defilePresent = false;
         for (auto& npc : npcs)
         {
@@ -1,6 +1,8 @@
 #include "RaidIccStrategy.h"
 
+#include "EncounterUnitRegistry.h"
 #include "RaidIccMultipliers.h"
+#include "RaidIccTriggers.h"
 
 void RaidIccStrategy::InitTriggers(std::vector<TriggerNode*>& triggers)
 {
@@ -184,3 +186,14 @@ void RaidIccStrategy::InitMultipliers(std::vector<Multiplier*>& multipliers)
     multipliers.push_back(new IccSindragosaMultiplier(botAI));
     multipliers.push_back(new IccLichKingAddsMultiplier(botAI));
 }
+
+void RaidIccStrategy::TrackEncounterUnits()
+{
+    sEncounterUnitRegistry->Track(ICC_MAP_ID, {
+        NPC_SHADE,
+        NPC_BIG_OOZE, NPC_GROWING_OOZE_PUDDLE, NPC_CHOKING_GAS_BOMB,
+        NPC_SWARMING_SHADOWS,
+        NPC_COLUMN_OF_FROST,
+        NPC_SPIRIT_BOMB, NPC_SHADOW_TRAP, DEFILE_NPC_ID
+    });
+}
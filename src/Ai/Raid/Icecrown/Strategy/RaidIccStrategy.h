@@ -13,6 +13,9 @@ public:
     virtual std::string const getName() override { return "icc"; }
     virtual void InitTriggers(std::vector<TriggerNode*>& triggers) override;
     virtual void InitMultipliers(std::vector<Multiplier*> &multipliers) override;
+
+    // Adds and mechanics looked up with the "encounter units" value, registered once at startup
+    static void TrackEncounterUnits();
 };
 
 #endif
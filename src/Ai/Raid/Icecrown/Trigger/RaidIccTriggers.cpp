@@ -298,7 +298,7 @@ bool IccPutricideGrowingOozePuddleTrigger::IsActive()
         //-------CHEAT-------
     }
 
-    const GuidVector& npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    const GuidVector& npcs = AI_VALUE2(GuidVector, "encounter units", NPC_GROWING_OOZE_PUDDLE);
     for (auto const& npc : npcs)
     {
         if (Unit* unit = botAI->GetUnit(npc))
@@ -1098,8 +1098,8 @@ bool IccLichKingShadowTrapTrigger::IsActive()
     if (boss->HealthBelowPct(65))
         return false;
 
-    // search for all nearby traps
-    GuidVector npcs = AI_VALUE(GuidVector, "nearest hostile npcs");
+    // search for all traps
+    GuidVector npcs = AI_VALUE2(GuidVector, "encounter units", NPC_SHADOW_TRAP);
     std::vector<Unit*> nearbyTraps;
     bool needToMove = false;
 
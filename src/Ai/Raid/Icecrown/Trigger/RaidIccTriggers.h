@@ -196,6 +196,8 @@ enum SpellIdsICC
     SPELL_REMORSELESS_WINTER8           = 74272,
 };
 
+const uint32 ICC_MAP_ID = 631;
+
 const uint32 DEFILE_AURAS[] = {72756, 74162, 74163, 74164};
 const uint32 DEFILE_CAST_ID = 72762;
 const uint32 DEFILE_NPC_ID = 38757;
@@ -215,8 +217,6 @@ const std::vector<uint32> availableTargetsGS          = {
     NPC_KOR_KRON_AXETHROWER, NPC_KOR_KRON_ROCKETEER,        NPC_KOR_KRON_BATTLE_MAGE, NPC_IGB_HIGH_OVERLORD_SAURFANG,
     NPC_SKYBREAKER_RIFLEMAN, NPC_SKYBREAKER_MORTAR_SOLDIER, NPC_SKYBREAKER_SORCERER,  NPC_IGB_MURADIN_BRONZEBEARD};
 
-static std::vector<ObjectGuid> sporeOrder;
-
 //Lord Marrowgar
 class IccLmTrigger : public Trigger
 {
@@ -1,6 +1,7 @@
 #include "RaidMagtheridonActions.h"
 #include "RaidMagtheridonHelpers.h"
 #include "Creature.h"
+#include "EncounterBlackboard.h"
 #include "ObjectAccessor.h"
 #include "ObjectGuid.h"
 #include "Playerbots.h"
@@ -396,9 +397,6 @@ bool MagtheridonMainTankPositionBossAction::Execute(Event event)
 
 // Ranged DPS will remain within 25 yards of the center of the room
 // Healers will remain within 15 yards of a position that is between ranged DPS and the boss
-std::unordered_map<ObjectGuid, Position> MagtheridonSpreadRangedAction::initialPositions;
-std::unordered_map<ObjectGuid, bool> MagtheridonSpreadRangedAction::hasReachedInitialPosition;
-
 bool MagtheridonSpreadRangedAction::Execute(Event event)
 {
     Unit* magtheridon = AI_VALUE2(Unit*, "find target", "magtheridon");
@@ -449,6 +447,14 @@ bool MagtheridonSpreadRangedAction::Execute(Event event)
     float centerZ = bot->GetPositionZ();
     const float radiusBuffer = 3.0f;
 
+    // Positions are handed out once per pull, the board is dropped on wipe or kill
+    EncounterBlackboard* board = context->GetEncounterBlackboard(magtheridon);
+    if (!board)
+        return false;
+
+    auto& initialPositions = board->Get<std::unordered_map<ObjectGuid, Position>>("ranged initial positions");
+    auto& hasReachedInitialPosition = board->Get<std::unordered_map<ObjectGuid, bool>>("ranged reached position");
+
     if (!initialPositions.count(bot->GetGUID()))
     {
         auto it = std::find(members.begin(), members.end(), bot);
@@ -679,8 +685,6 @@ bool MagtheridonManageTimersAndAssignmentsAction::Execute(Event event)
     }
     else
     {
-        MagtheridonSpreadRangedAction::initialPositions.clear();
-        MagtheridonSpreadRangedAction::hasReachedInitialPosition.clear();
         botToCubeAssignment.clear();
 
         if (IsInstanceTimerManager(botAI, bot))
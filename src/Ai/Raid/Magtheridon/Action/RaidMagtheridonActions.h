@@ -67,9 +67,6 @@ public:
 class MagtheridonSpreadRangedAction : public MovementAction
 {
 public:
-    static std::unordered_map<ObjectGuid, Position> initialPositions;
-    static std::unordered_map<ObjectGuid, bool> hasReachedInitialPosition;
-
     MagtheridonSpreadRangedAction(PlayerbotAI* botAI, std::string const name = "magtheridon spread ranged") : MovementAction(botAI, name) {};
 
     bool Execute(Event event) override;
@@ -1008,7 +1008,7 @@ bool RazorscaleHarpoonAction::Execute(Event event)
 
         if (GameObject* harpoonGO = bot->FindNearestGameObject(harpoon.gameObjectEntry, 200.0f))
         {
-            if (RazorscaleBossHelper::IsHarpoonReady(harpoonGO))
+            if (razorscaleHelper.IsHarpoonReady(harpoonGO))
             {
                 float distance = bot->GetDistance2d(harpoonGO);
                 if (distance < minDistance)
@@ -1068,7 +1068,7 @@ bool RazorscaleHarpoonAction::Execute(Event event)
         bot->GetSession()->HandleGameobjectReportUse(reportPacket);
     }
 
-    RazorscaleBossHelper::SetHarpoonOnCooldown(closestHarpoon);
+    razorscaleHelper.SetHarpoonOnCooldown(closestHarpoon);
 
     return true;
 }
@@ -1094,7 +1094,7 @@ bool RazorscaleHarpoonAction::isUseful()
 
         if (GameObject* harpoonGO = bot->FindNearestGameObject(harpoon.gameObjectEntry, 200.0f))
         {
-            if (RazorscaleBossHelper::IsHarpoonReady(harpoonGO))
+            if (razorscaleHelper.IsHarpoonReady(harpoonGO))
             {
                 // Check if this bot is a ranged DPS (not a healer)
                 if (botAI->IsRanged(bot) && botAI->IsDps(bot) && !botAI->IsHeal(bot))
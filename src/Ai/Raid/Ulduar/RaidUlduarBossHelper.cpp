@@ -1,5 +1,6 @@
 #include "ChatHelper.h"
 #include "RaidUlduarBossHelper.h"
+#include "EncounterBlackboard.h"
 #include "ObjectAccessor.h"
 #include "GameObject.h"
 #include "Group.h"
@@ -9,10 +10,6 @@
 #include "Playerbots.h"
 #include "World.h"
 
-// Prevent harpoon spam
-std::unordered_map<ObjectGuid, time_t> RazorscaleBossHelper::_harpoonCooldowns;
-// Prevent role assignment spam
-std::unordered_map<ObjectGuid, std::time_t> RazorscaleBossHelper::_lastRoleSwapTime;
 const std::time_t RazorscaleBossHelper::_roleSwapCooldown;
 
 bool RazorscaleBossHelper::UpdateBossAI()
@@ -53,30 +50,39 @@ bool RazorscaleBossHelper::IsHarpoonFired(uint32 chainSpellId) const
     return _boss && _boss->HasAura(chainSpellId);
 }
 
-bool RazorscaleBossHelper::IsHarpoonReady(GameObject* harpoonGO)
+bool RazorscaleBossHelper::IsHarpoonReady(GameObject* harpoonGO) const
 {
     if (!harpoonGO)
         return false;
 
-    auto it = _harpoonCooldowns.find(harpoonGO->GetGUID());
-    if (it != _harpoonCooldowns.end())
+    // Prevent harpoon spam
+    if (EncounterBlackboard* board = context->GetEncounterBlackboard(_boss))
     {
-        time_t currentTime = std::time(nullptr);
-        time_t elapsedTime = currentTime - it->second;
-        if (elapsedTime < HARPOON_COOLDOWN_DURATION)
-            return false;
+        auto& harpoonCooldowns = board->Get<std::unordered_map<ObjectGuid, time_t>>("harpoon cooldowns");
+        auto it = harpoonCooldowns.find(harpoonGO->GetGUID());
+        if (it != harpoonCooldowns.end())
+        {
+            time_t currentTime = std::time(nullptr);
+            time_t elapsedTime = currentTime - it->second;
+            if (elapsedTime < HARPOON_COOLDOWN_DURATION)
+                return false;
+        }
     }
 
     return harpoonGO->GetGoState() == GO_STATE_READY;
 }
 
-void RazorscaleBossHelper::SetHarpoonOnCooldown(GameObject* harpoonGO)
+void RazorscaleBossHelper::SetHarpoonOnCooldown(GameObject* harpoonGO) const
 {
     if (!harpoonGO)
         return;
 
+    EncounterBlackboard* board = context->GetEncounterBlackboard(_boss);
+    if (!board)
+        return;
+
     time_t currentTime = std::time(nullptr);
-    _harpoonCooldowns[harpoonGO->GetGUID()] = currentTime;
+    board->Get<std::unordered_map<ObjectGuid, time_t>>("harpoon cooldowns")[harpoonGO->GetGUID()] = currentTime;
 }
 
 GameObject* RazorscaleBossHelper::FindNearestHarpoon(float x, float y, float z) const
@@ -143,17 +149,16 @@ bool RazorscaleBossHelper::CanSwapRoles() const
     if (!botGuid)
         return false;
 
-    // If no entry exists yet for this bot, initialize it to 0
-    auto it = _lastRoleSwapTime.find(botGuid);
-    if (it == _lastRoleSwapTime.end())
-    {
-        _lastRoleSwapTime[botGuid] = 0;
-        it = _lastRoleSwapTime.find(botGuid);
-    }
+    // Prevent role assignment spam, the last swap is tracked per bot for this pull
+    EncounterBlackboard* board = context->GetEncounterBlackboard(_boss);
+    if (!board)
+        return true;
+
+    // No entry yet for this bot counts as never swapped
+    std::time_t lastSwapTime = board->Get<std::unordered_map<ObjectGuid, std::time_t>>("role swap times")[botGuid];
 
     // Compare the current time against the stored time
     std::time_t currentTime = std::time(nullptr);
-    std::time_t lastSwapTime = it->second;
 
     return (currentTime - lastSwapTime) >= _roleSwapCooldown;
 }
@@ -221,5 +226,6 @@ void RazorscaleBossHelper::AssignRolesBasedOnHealth()
         return;
 
     // Set current time in the cooldown map for this bot to start cooldown
-    _lastRoleSwapTime[botGuid] = std::time(nullptr);
+    if (EncounterBlackboard* board = context->GetEncounterBlackboard(_boss))
+        board->Get<std::unordered_map<ObjectGuid, std::time_t>>("role swap times")[botGuid] = std::time(nullptr);
 }
@@ -81,8 +81,8 @@ public:
     bool IsFlyingPhase() const;
 
     bool IsHarpoonFired(uint32 chainSpellId) const;
-    static bool IsHarpoonReady(GameObject* harpoonGO);
-    static void SetHarpoonOnCooldown(GameObject* harpoonGO);
+    bool IsHarpoonReady(GameObject* harpoonGO) const;
+    void SetHarpoonOnCooldown(GameObject* harpoonGO) const;
     GameObject* FindNearestHarpoon(float x, float y, float z) const;
 
     static const std::vector<HarpoonData>& GetHarpoonData();
@@ -94,13 +94,8 @@ public:
 private:
     Unit* _boss;
 
-    // A map to track the last role swap *per bot* by their GUID
-    static std::unordered_map<ObjectGuid, std::time_t> _lastRoleSwapTime;
-
-    // The cooldown that applies to every bot
+    // The cooldown that applies to every bot, the last swap per bot is kept on the encounter board
     static const std::time_t _roleSwapCooldown = 10;
-
-    static std::unordered_map<ObjectGuid, time_t> _harpoonCooldowns;
 };
 
 // template <class BossAiType>
@@ -222,7 +222,7 @@ bool RazorscaleHarpoonAvailableTrigger::IsActive()
         // Find the nearest harpoon GameObject within 200 yards
         if (GameObject* harpoonGO = bot->FindNearestGameObject(harpoon.gameObjectEntry, 200.0f))
         {
-            if (RazorscaleBossHelper::IsHarpoonReady(harpoonGO))
+            if (razorscaleHelper.IsHarpoonReady(harpoonGO))
             {
                 return true;  // At least one harpoon is available and ready to be fired
             }
@@ -22,10 +22,12 @@
 #include "Playerbots.h"
 #include "Position.h"
 #include "QuestDef.h"
+#include "QuestPOIIndex.h"
 #include "Random.h"
 #include "RandomPlayerbotMgr.h"
 #include "SharedDefines.h"
 #include "StatsWeightCalculator.h"
+#include "TaxiRouteTable.h"
 #include "Timer.h"
 #include "TravelMgr.h"
 
@@ -714,72 +716,32 @@ bool NewRpgBaseAction::HasQuestToAcceptOrReward(WorldObject* object)
     return false;
 }
 
-static std::vector<float> GenerateRandomWeights(int n)
-{
-    std::vector<float> weights(n);
-    float sum = 0.0;
-
-    for (int i = 0; i < n; ++i)
-    {
-        weights[i] = rand_norm();
-        sum += weights[i];
-    }
-    for (int i = 0; i < n; ++i)
-    {
-        weights[i] /= sum;
-    }
-    return weights;
-}
-
 bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector<POIInfo>& poiInfo, bool toComplete)
 {
     Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
     if (!quest)
         return false;
 
-    const QuestPOIVector* poiVector = sObjectMgr->GetQuestPOIVector(questId);
-    if (!poiVector)
-    {
+    QuestPOILocation const* first = sQuestPOIIndex->QuestBegin(questId);
+    QuestPOILocation const* last = sQuestPOIIndex->QuestEnd(questId);
+    if (first == last)
         return false;
-    }
 
     const QuestStatusData& q_status = bot->getQuestStatusMap().at(questId);
 
     if (toComplete && q_status.Status == QUEST_STATUS_COMPLETE)
     {
-        for (const QuestPOI& qPoi : *poiVector)
+        for (QuestPOILocation const* poi = first; poi != last; ++poi)
         {
-            if (qPoi.MapId != bot->GetMapId())
-                continue;
-
             // not the poi pos to reward quest
-            if (qPoi.ObjectiveIndex != -1)
-                continue;
-
-            if (qPoi.points.size() == 0)
-                continue;
-
-            float dx = 0, dy = 0;
-            std::vector<float> weights = GenerateRandomWeights(qPoi.points.size());
-            for (size_t i = 0; i < qPoi.points.size(); i++)
-            {
-                const QuestPOIPoint& point = qPoi.points[i];
-                dx += point.x * weights[i];
-                dy += point.y * weights[i];
-            }
-
-            if (bot->GetDistance2d(dx, dy) >= 1500.0f)
-                continue;
-
-            float dz = std::max(bot->GetMap()->GetHeight(dx, dy, MAX_HEIGHT), bot->GetMap()->GetWaterLevel(dx, dy));
-
-            if (dz == INVALID_HEIGHT || dz == VMAP_INVALID_HEIGHT_VALUE)
+            if (poi->objectiveIdx != -1)
                 continue;
 
-            if (bot->GetZoneId() != bot->GetMap()->GetZoneId(bot->GetPhaseMask(), dx, dy, dz))
+            float dx, dy;
+            if (!sQuestPOIIndex->SelectSample(bot, *poi, 1500.0f, dx, dy))
                 continue;
 
-            poiInfo.push_back({{dx, dy}, qPoi.ObjectiveIndex});
+            poiInfo.push_back({{dx, dy}, poi->objectiveIdx});
         }
 
         if (poiInfo.empty())
@@ -813,45 +775,17 @@ bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector
     }
 
     // Get POIs to go
-    for (const QuestPOI& qPoi : *poiVector)
+    for (QuestPOILocation const* poi = first; poi != last; ++poi)
     {
-        if (qPoi.MapId != bot->GetMapId())
+        if (std::find(incompleteObjectiveIdx.begin(), incompleteObjectiveIdx.end(), poi->objectiveIdx) ==
+            incompleteObjectiveIdx.end())
             continue;
 
-        bool inComplete = false;
-        for (uint32 objective : incompleteObjectiveIdx)
-        {
-            if (qPoi.ObjectiveIndex == objective)
-            {
-                inComplete = true;
-                break;
-            }
-        }
-        if (!inComplete)
-            continue;
-        if (qPoi.points.size() == 0)
-            continue;
-        float dx = 0, dy = 0;
-        std::vector<float> weights = GenerateRandomWeights(qPoi.points.size());
-        for (size_t i = 0; i < qPoi.points.size(); i++)
-        {
-            const QuestPOIPoint& point = qPoi.points[i];
-            dx += point.x * weights[i];
-            dy += point.y * weights[i];
-        }
-
-        if (bot->GetDistance2d(dx, dy) >= 1500.0f)
-            continue;
-
-        float dz = std::max(bot->GetMap()->GetHeight(dx, dy, MAX_HEIGHT), bot->GetMap()->GetWaterLevel(dx, dy));
-
-        if (dz == INVALID_HEIGHT || dz == VMAP_INVALID_HEIGHT_VALUE)
-            continue;
-
-        if (bot->GetZoneId() != bot->GetMap()->GetZoneId(bot->GetPhaseMask(), dx, dy, dz))
+        float dx, dy;
+        if (!sQuestPOIIndex->SelectSample(bot, *poi, 1500.0f, dx, dy))
             continue;
 
-        poiInfo.push_back({{dx, dy}, qPoi.ObjectiveIndex});
+        poiInfo.push_back({{dx, dy}, poi->objectiveIdx});
     }
 
     if (poiInfo.size() == 0)
@@ -995,48 +929,31 @@ bool NewRpgBaseAction::SelectRandomFlightTaxiNode(ObjectGuid& flightMaster, uint
         return false;
 
     std::vector<uint32> availableToNodes;
-    for (uint32 i = 1; i < sTaxiNodesStore.GetNumRows(); ++i)
+    TaxiRoute const* last = sTaxiRouteTable->RoutesEnd(bot->GetTeamId(), fromNode);
+    for (TaxiRoute const* route = sTaxiRouteTable->RoutesBegin(bot->GetTeamId(), fromNode); route != last; ++route)
     {
-        if (fromNode == i)
-            continue;
-
-        TaxiNodesEntry const* node = sTaxiNodesStore.LookupEntry(i);
-
         // check map
-        if (!node || node->map_id != bot->GetMapId() ||
-            (!node->MountCreatureID[bot->GetTeamId() == TEAM_ALLIANCE ? 1 : 0]))  // dk flight
+        TaxiRouteNode const* node = sTaxiRouteTable->GetNode(route->toNode);
+        if (!node || node->mapId != bot->GetMapId())
             continue;
 
         // check taxi node known
-        if (!bot->isTaxiCheater() && !bot->m_taxi.IsTaximaskNodeKnown(i))
+        if (!bot->isTaxiCheater() && !bot->m_taxi.IsTaximaskNodeKnown(route->toNode))
             continue;
 
         // check distance by level
-        if (!botAI->CheckLocationDistanceByLevel(bot, WorldLocation(node->map_id, node->x, node->y, node->z), false))
-            continue;
-
-        // check path
-        uint32 path, cost;
-        sObjectMgr->GetTaxiPath(fromNode, i, path, cost);
-        if (!path)
+        if (!botAI->CheckLocationDistanceByLevel(bot, WorldLocation(node->mapId, node->x, node->y, node->z), false))
             continue;
 
         // check area level
-        uint32 nodeZoneId = bot->GetMap()->GetZoneId(bot->GetPhaseMask(), node->x, node->y, node->z);
-        bool capital = false;
-        if (AreaTableEntry const* zone = sAreaTableStore.LookupEntry(nodeZoneId))
-        {
-            capital = zone->flags & AREA_FLAG_CAPITAL;
-        }
-
-        auto itr = sRandomPlayerbotMgr->zone2LevelBracket.find(nodeZoneId);
-        if (!capital && itr == sRandomPlayerbotMgr->zone2LevelBracket.end())
+        uint8 low, high;
+        if (!sTaxiRouteTable->GetLevelBand(bot, route->toNode, low, high))
             continue;
 
-        if (!capital && (bot->GetLevel() < itr->second.low || bot->GetLevel() > itr->second.high))
+        if (bot->GetLevel() < low || bot->GetLevel() > high)
             continue;
 
-        availableToNodes.push_back(i);
+        availableToNodes.push_back(route->toNode);
     }
     if (availableToNodes.empty())
         return false;
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "ChatCommandMessage.h"
+
+#include "Helpers.h"
+#include "PlayerbotAIConfig.h"
+
+static std::vector<std::pair<std::string, ChatMsg>> const chatRedirects = {
+    {"#a ", CHAT_MSG_ADDON},
+    {"#g ", CHAT_MSG_GUILD},
+    {"#p ", CHAT_MSG_PARTY},
+    {"#r ", CHAT_MSG_RAID},
+    {"#w ", CHAT_MSG_WHISPER},
+};
+
+ChatCommandMessage::ChatCommandMessage(uint32 type, std::string const& text) : type(type)
+{
+    if (type == CHAT_MSG_ADDON || type == CHAT_MSG_SYSTEM)
+        return;
+
+    std::vector<std::string> pieces;
+    if (text.find(sPlayerbotAIConfig->commandSeparator) != std::string::npos)
+        split(pieces, text, sPlayerbotAIConfig->commandSeparator.c_str());
+    else
+        pieces.push_back(text);
+
+    for (std::string& filtered : pieces)
+    {
+        if (!sPlayerbotAIConfig->commandPrefix.empty())
+        {
+            if (filtered.find(sPlayerbotAIConfig->commandPrefix) != 0)
+                continue;
+
+            filtered = filtered.substr(sPlayerbotAIConfig->commandPrefix.size());
+        }
+
+        ParsedChatCommand command;
+        for (auto const& redirect : chatRedirects)
+        {
+            if (filtered.find(redirect.first) == 0)
+            {
+                filtered = filtered.substr(3);
+                command.replyChat = redirect.second;
+                command.redirected = true;
+                break;
+            }
+        }
+
+        trim(filtered);
+        if (filtered.empty())
+            continue;
+
+        command.targeted = filtered[0] == '@';
+        command.text = std::move(filtered);
+        commands.push_back(std::move(command));
+    }
+}
+
+bool ChatCommandMessage::IsTargeted() const
+{
+    for (ParsedChatCommand const& command : commands)
+    {
+        if (command.targeted)
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_CHATCOMMANDMESSAGE_H
+#define _PLAYERBOT_CHATCOMMANDMESSAGE_H
+
+#include <memory>
+#include <vector>
+
+#include "Common.h"
+#include "SharedDefines.h"
+
+struct ParsedChatCommand
+{
+    std::string text;                     // command without prefix and chat redirect, trimmed
+    ChatMsg replyChat = CHAT_MSG_WHISPER;  // "#p ", "#r " ... redirect, whisper otherwise
+    bool redirected = false;
+    bool targeted = false;                // starts with an @filter, only some bots will accept it
+};
+
+// Chat line pre-parsed once (separator split, command prefix, chat redirect, trim) and then shared read-only
+// between all bots receiving it. Per-bot work (security, chat filters) stays in PlayerbotAI::HandleCommand.
+class ChatCommandMessage
+{
+public:
+    ChatCommandMessage(uint32 type, std::string const& text);
+
+    uint32 GetType() const { return type; }
+    std::vector<ParsedChatCommand> const& GetCommands() const { return commands; }
+    bool IsEmpty() const { return commands.empty(); }
+    bool IsTargeted() const;
+
+private:
+    uint32 const type;
+    std::vector<ParsedChatCommand> commands;
+};
+
+typedef std::shared_ptr<ChatCommandMessage const> ChatCommandMessagePtr;
+
+#endif
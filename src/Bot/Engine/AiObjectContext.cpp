@@ -10,6 +10,7 @@
 #include "ChatTriggerContext.h"
 #include "DKAiObjectContext.h"
 #include "DruidAiObjectContext.h"
+#include "EncounterBlackboard.h"
 #include "HunterAiObjectContext.h"
 #include "MageAiObjectContext.h"
 #include "PaladinAiObjectContext.h"
@@ -69,6 +70,7 @@ AiObjectContext::AiObjectContext(PlayerbotAI* botAI, SharedNamedObjectContextLis
       triggerContexts(sharedTriggerContext),
       valueContexts(sharedValueContext)
 {
+    valueContexts.SetLruCapacities(sPlayerbotAIConfig->valueCacheCapacities);
 }
 
 void AiObjectContext::BuildAllSharedContexts()
@@ -244,6 +246,26 @@ UntypedValue* AiObjectContext::GetUntypedValue(std::string const name)
 
 std::set<std::string> AiObjectContext::GetValues() { return valueContexts.GetCreated(); }
 
+std::string const AiObjectContext::FormatObjectStats() const
+{
+    std::ostringstream out;
+    out << strategyContexts.created.size() << " strategies, " << actionContexts.created.size() << " actions, "
+        << triggerContexts.created.size() << " triggers, " << valueContexts.created.size() << " values, ~"
+        << GetEstimatedSize() / 1024 << " KB";
+    return out.str();
+}
+
+uint64 AiObjectContext::GetEstimatedSize() const
+{
+    return strategyContexts.GetEstimatedSize() + actionContexts.GetEstimatedSize() +
+           triggerContexts.GetEstimatedSize() + valueContexts.GetEstimatedSize();
+}
+
+EncounterBlackboard* AiObjectContext::GetEncounterBlackboard(Unit* boss)
+{
+    return sEncounterBlackboardMgr->Get(boss);
+}
+
 std::set<std::string> AiObjectContext::GetSupportedStrategies() { return strategyContexts.supports(); }
 
 std::set<std::string> AiObjectContext::GetSupportedActions() { return actionContexts.supports(); }
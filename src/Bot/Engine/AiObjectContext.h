@@ -17,6 +17,7 @@
 #include "Trigger.h"
 #include "Value.h"
 
+class EncounterBlackboard;
 class PlayerbotAI;
 
 typedef Strategy* (*StrategyCreator)(PlayerbotAI* botAI);
@@ -69,6 +70,18 @@ public:
     std::vector<std::string> Save();
     void Load(std::vector<std::string> data);
 
+    // Evicts least recently used values of the bounded families (AiPlayerbot.ValueCacheCapacity)
+    uint32 TrimValues() { return valueContexts.Trim(); }
+    std::vector<NamedObjectContextList<UntypedValue>::LruFamily> const& GetValueFamilies() const
+    {
+        return valueContexts.GetLruFamilies();
+    }
+    std::string const FormatObjectStats() const;
+    uint64 GetEstimatedSize() const;
+
+    // Shared by the bots of this instance fighting the boss, nullptr unless the boss is alive and engaged
+    EncounterBlackboard* GetEncounterBlackboard(Unit* boss);
+
     std::vector<std::string> performanceStack;
 
     static void BuildAllSharedContexts();
@@ -59,12 +59,11 @@ public:
             name = name.substr(0, found);
         }
 
-        if (creators.find(name) == creators.end())
+        typename std::unordered_map<std::string, ObjectCreator>::const_iterator itr = creators.find(name);
+        if (itr == creators.end())
             return nullptr;
 
-        ObjectCreator& creator = creators[name];
-
-        T* object = creator(botAI);
+        T* object = itr->second(botAI);
         Qualified* q = dynamic_cast<Qualified*>(object);
         if (q && found != std::string::npos)
             q->Qualify(qualifier);
@@ -203,13 +202,81 @@ public:
 
     T* GetContextObject(const std::string& name, PlayerbotAI* botAI)
     {
-        if (created.find(name) == created.end())
+        typename std::unordered_map<std::string, T*>::iterator itr = created.find(name);
+        if (itr == created.end())
+            itr = created.emplace(name, create(name, botAI)).first;
+
+        if (!lruFamilies.empty() && itr->second)
+            Touch(itr->first);
+
+        return itr->second;
+    }
+
+    // Qualified objects ("family::qualifier") of a bounded family are kept in least recently used order, Trim
+    // deletes the oldest ones over the family capacity.
+    struct LruFamily
+    {
+        std::string name;
+        uint32 capacity = 0;
+        std::list<std::string> order;  // most recently used first
+        uint64 evictions = 0;
+    };
+
+    void SetLruCapacities(std::unordered_map<std::string, uint32> const& capacities)
+    {
+        for (auto const& itr : capacities)
         {
-            if (T* object = create(name, botAI))
-                return created[name] = object;
+            LruFamily family;
+            family.name = itr.first;
+            family.capacity = itr.second;
+            lruFamilies.push_back(family);
         }
+    }
 
-        return created[name];
+    // Objects returned by GetContextObject may be deleted, only call between updates when nobody holds them
+    uint32 Trim()
+    {
+        uint32 evicted = 0;
+        for (LruFamily& family : lruFamilies)
+        {
+            while (family.order.size() > family.capacity)
+            {
+                std::string const& name = family.order.back();
+
+                typename std::unordered_map<std::string, T*>::iterator itr = created.find(name);
+                if (itr != created.end())
+                {
+                    delete itr->second;
+                    created.erase(itr);
+                }
+
+                lruPositions.erase(name);
+                family.order.pop_back();
+                ++family.evictions;
+                ++evicted;
+            }
+        }
+
+        return evicted;
+    }
+
+    std::vector<LruFamily> const& GetLruFamilies() const { return lruFamilies; }
+
+    // Map node, key and the object itself, heap owned by the objects (containers, long strings) is not counted
+    uint64 GetEstimatedSize() const
+    {
+        uint64 size = created.bucket_count() * sizeof(void*);
+        for (auto const& itr : created)
+        {
+            size += sizeof(void*) + sizeof(size_t) + sizeof(std::pair<std::string const, T*>) + itr.first.capacity();
+            if (itr.second)
+                size += sizeof(T) + itr.first.size();  // the object keeps its own copy of name and qualifier
+        }
+
+        for (LruFamily const& family : lruFamilies)
+            size += family.order.size() * (2 * sizeof(void*) + sizeof(std::string));
+
+        return size;
     }
 
     std::set<std::string> GetSiblings(const std::string& name)
@@ -252,6 +319,42 @@ public:
 
         return result;
     }
+
+private:
+    LruFamily* FindLruFamily(std::string const& name)
+    {
+        if (name.find("::") == std::string::npos)
+            return nullptr;
+
+        for (LruFamily& family : lruFamilies)
+        {
+            if (name.size() > family.name.size() + 2 && !name.compare(0, family.name.size(), family.name) &&
+                !name.compare(family.name.size(), 2, "::"))
+                return &family;
+        }
+
+        return nullptr;
+    }
+
+    void Touch(std::string const& name)
+    {
+        LruFamily* family = FindLruFamily(name);
+        if (!family)
+            return;
+
+        typename std::unordered_map<std::string, typename std::list<std::string>::iterator>::iterator itr =
+            lruPositions.find(name);
+        if (itr == lruPositions.end())
+        {
+            family->order.push_front(name);
+            lruPositions[name] = family->order.begin();
+        }
+        else
+            family->order.splice(family->order.begin(), family->order, itr->second);
+    }
+
+    std::vector<LruFamily> lruFamilies;
+    std::unordered_map<std::string, typename std::list<std::string>::iterator> lruPositions;
 };
 
 template <class T>
@@ -6,6 +6,8 @@
 #ifndef _PLAYERBOT_PLAYERBOTAIBASE_H
 #define _PLAYERBOT_PLAYERBOTAIBASE_H
 
+#include <atomic>
+
 #include "Define.h"
 #include "PlayerbotAIConfig.h"
 
@@ -23,12 +25,17 @@ public:
     bool IsActive();
     bool IsBotAI() const;
 
+    // Packed PlayerRoleProfile of the player, read and written by AiFactory::GetPlayerRoleProfile from any thread
+    uint64 GetRoleProfile() const { return roleProfile.load(std::memory_order_relaxed); }
+    void SetRoleProfile(uint64 profile) { roleProfile.store(profile, std::memory_order_relaxed); }
+
 protected:
     uint32 nextAICheckDelay;
     class PerfMonitorOperation* totalPmo = nullptr;
 
 private:
     bool _isBotAI;
+    std::atomic<uint64> roleProfile{0};
 };
 
 #endif
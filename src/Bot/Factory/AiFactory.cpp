@@ -55,7 +55,72 @@ AiObjectContext* AiFactory::createAiObjectContext(Player* player, PlayerbotAI* b
     return new AiObjectContext(botAI);
 }
 
-uint8 AiFactory::GetPlayerSpecTab(Player* bot)
+uint8 AiFactory::GetPlayerSpecTab(Player* bot) { return GetPlayerRoleProfile(bot).tab; }
+
+uint32 AiFactory::GetRoleProfileStamp(Player* player)
+{
+    // Learning or resetting talents changes the free points, a spec swap the active spec
+    return (player->GetActiveSpec() & 0x1) | ((player->GetLevel() & 0x7F) << 1) |
+           ((player->GetFreeTalentPoints() & 0xFF) << 8) | ((player->GetTalentMap().size() & 0xFFFF) << 16);
+}
+
+PlayerRoleProfile AiFactory::GetPlayerRoleProfile(Player* player)
+{
+    // valid bit | roles << 40 | tab << 32 | stamp
+    static uint64 const VALID = uint64(1) << 63;
+
+    uint32 const stamp = GetRoleProfileStamp(player);
+
+    PlayerbotAIBase* holder = sPlayerbotsMgr->GetPlayerbotAIBase(player);
+    if (holder)
+    {
+        uint64 const cached = holder->GetRoleProfile();
+        if ((cached & VALID) && uint32(cached) == stamp)
+            return {uint8(cached >> 32), uint8(cached >> 40)};
+    }
+
+    PlayerRoleProfile profile;
+    profile.tab = CalculatePlayerSpecTab(player);
+    profile.roles = GetSpecRoles(player->getClass(), profile.tab);
+
+    if (holder)
+        holder->SetRoleProfile(VALID | (uint64(profile.roles) << 40) | (uint64(profile.tab) << 32) | stamp);
+
+    return profile;
+}
+
+uint8 AiFactory::GetSpecRoles(uint8 cls, uint8 tab)
+{
+    switch (cls)
+    {
+        case CLASS_DEATH_KNIGHT:
+            return tab == DEATH_KNIGHT_TAB_BLOOD ? SPEC_ROLE_TANK : SPEC_ROLE_DPS;
+        case CLASS_WARRIOR:
+            return tab == WARRIOR_TAB_PROTECTION ? SPEC_ROLE_TANK : SPEC_ROLE_DPS;
+        case CLASS_ROGUE:
+            return SPEC_ROLE_DPS;
+        case CLASS_PALADIN:
+            if (tab == PALADIN_TAB_HOLY)
+                return SPEC_ROLE_HEAL | SPEC_ROLE_RANGED;
+            if (tab == PALADIN_TAB_PROTECTION)
+                return SPEC_ROLE_TANK;
+            return tab == PALADIN_TAB_RETRIBUTION ? SPEC_ROLE_DPS : 0;
+        case CLASS_DRUID:
+            if (tab == DRUID_TAB_FERAL)
+                return SPEC_ROLE_FERAL;
+            return SPEC_ROLE_RANGED | (tab == DRUID_TAB_RESTORATION ? SPEC_ROLE_HEAL : SPEC_ROLE_DPS);
+        case CLASS_SHAMAN:
+            if (tab == SHAMAN_TAB_RESTORATION)
+                return SPEC_ROLE_HEAL | SPEC_ROLE_RANGED;
+            return tab == SHAMAN_TAB_ENHANCEMENT ? SPEC_ROLE_DPS : SPEC_ROLE_DPS | SPEC_ROLE_RANGED;
+        case CLASS_PRIEST:
+            return SPEC_ROLE_RANGED | (tab == PRIEST_TAB_SHADOW ? SPEC_ROLE_DPS : SPEC_ROLE_HEAL);
+        default:  // mage, warlock, hunter
+            return SPEC_ROLE_DPS | SPEC_ROLE_RANGED;
+    }
+}
+
+uint8 AiFactory::CalculatePlayerSpecTab(Player* bot)
 {
     std::map<uint8, uint32> tabs = GetPlayerSpecTabs(bot);
 
@@ -17,6 +17,22 @@ class PlayerbotAI;
 
 enum BotRoles : uint8;
 
+// Roles implied by the talent spec, as used by PlayerbotAI::IsTank / IsHeal / IsDps / IsRanged with bySpec
+enum PlayerSpecRole : uint8
+{
+    SPEC_ROLE_TANK = 1 << 0,
+    SPEC_ROLE_HEAL = 1 << 1,
+    SPEC_ROLE_DPS = 1 << 2,
+    SPEC_ROLE_RANGED = 1 << 3,
+    SPEC_ROLE_FERAL = 1 << 4  // tank in bear form, dps otherwise, neither flag is set
+};
+
+struct PlayerRoleProfile
+{
+    uint8 tab;
+    uint8 roles;  // PlayerSpecRole
+};
+
 class AiFactory
 {
 public:
@@ -30,8 +46,15 @@ public:
 
     static uint8 GetPlayerSpecTab(Player* player);
     static std::map<uint8, uint32> GetPlayerSpecTabs(Player* player);
+    // Cached on the player's PlayerbotAI / PlayerbotMgr, recalculated when level, talents or active spec change
+    static PlayerRoleProfile GetPlayerRoleProfile(Player* player);
     static BotRoles GetPlayerRoles(Player* player);
     static std::string GetPlayerSpecName(Player* player);
+
+private:
+    static uint8 CalculatePlayerSpecTab(Player* player);
+    static uint8 GetSpecRoles(uint8 cls, uint8 tab);
+    static uint32 GetRoleProfileStamp(Player* player);
 };
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "PlayerbotFactory.h"
 
+#include <algorithm>
 #include <random>
 #include <utility>
 
@@ -230,6 +231,59 @@ void PlayerbotFactory::Prepare()
 }
 
 void PlayerbotFactory::Randomize(bool incremental)
+{
+    // A plan still queued for an earlier randomize would undo this one
+    sPlayerbotFactoryPlanner->Cancel(bot->GetGUID());
+
+    RandomizeBeforeEquipment(incremental);
+    ApplyPlan(Plan(GetPlanInput(incremental)));
+}
+
+void PlayerbotFactory::RandomizeAsync(bool incremental)
+{
+    RandomizeBeforeEquipment(incremental);
+
+    // Supersedes a plan still queued for an earlier randomize, which was made for the old level
+    PlayerbotFactoryPlanInput const input = GetPlanInput(incremental);
+    if (sPlayerbotFactoryPlanner->Submit(input))
+        return;
+
+    sPlayerbotFactoryPlanner->Cancel(bot->GetGUID());
+    ApplyPlan(Plan(input));
+}
+
+PlayerbotFactoryPlanInput PlayerbotFactory::GetPlanInput(bool incremental)
+{
+    PlayerbotFactoryPlanInput input;
+    input.guid = bot->GetGUID();
+    input.cls = bot->getClass();
+    input.level = bot->GetLevel();
+    input.itemQuality = itemQuality;
+    input.gearScoreLimit = gearScoreLimit;
+    input.collectorType = StatsWeightCalculator(bot).GetCollectorType();
+    input.armorSkills = GetArmorSkills();
+    input.incremental = incremental;
+    input.planGear = (!incremental || !sPlayerbotAIConfig->equipmentPersistence ||
+                      bot->GetLevel() < sPlayerbotAIConfig->equipmentPersistenceLevel) &&
+                     (sPlayerbotAIConfig->incrementalGearInit || !incremental);
+    input.planEnchants = bot->GetLevel() >= sPlayerbotAIConfig->minEnchantingBotLevel;
+    return input;
+}
+
+PlayerbotFactoryPlan PlayerbotFactory::Plan(PlayerbotFactoryPlanInput const& input)
+{
+    PlayerbotFactoryPlan plan;
+    plan.input = input;
+    if (input.planGear)
+        PlanEquipment(plan);
+
+    if (input.planEnchants)
+        PlanEnchants(plan);
+
+    return plan;
+}
+
+void PlayerbotFactory::RandomizeBeforeEquipment(bool incremental)
 {
     // if (sPlayerbotAIConfig->disableRandomLevels)
     // {
@@ -350,14 +404,16 @@ void PlayerbotFactory::Randomize(bool incremental)
     // if (pmo)
     //     pmo->finish();
 
-    pmo = sPerfMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Equip");
+}
+
+void PlayerbotFactory::ApplyPlan(PlayerbotFactoryPlan const& plan)
+{
+    bool const incremental = plan.input.incremental;
+
+    PerfMonitorOperation* pmo = sPerfMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Equip");
     LOG_DEBUG("playerbots", "Initializing equipmemt...");
-    if (!incremental || !sPlayerbotAIConfig->equipmentPersistence ||
-        bot->GetLevel() < sPlayerbotAIConfig->equipmentPersistenceLevel)
-    {
-        if (sPlayerbotAIConfig->incrementalGearInit || !incremental)
-            InitEquipment(incremental, incremental ? false : sPlayerbotAIConfig->twoRoundsGearInit);
-    }
+    if (plan.input.planGear)
+        InitEquipment(plan, incremental ? false : sPlayerbotAIConfig->twoRoundsGearInit);
     // bot->SaveToDB(false, false);
     if (pmo)
         pmo->finish();
@@ -414,9 +470,9 @@ void PlayerbotFactory::Randomize(bool incremental)
     // if (pmo)
     //     pmo->finish();
 
-    if (bot->GetLevel() >= sPlayerbotAIConfig->minEnchantingBotLevel)
+    if (plan.input.planEnchants)
     {
-        ApplyEnchantAndGemsNew();
+        ApplyEnchantAndGemsNew(plan);
     }
     // {
     // pmo = sPerfMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_EnchantTemplate");
@@ -1351,30 +1407,38 @@ private:
     std::set<uint32> keep;
 };
 
-bool PlayerbotFactory::CanEquipArmor(ItemTemplate const* proto)
+bool PlayerbotFactory::CanEquipArmor(ItemTemplate const* proto) { return CanEquipArmor(GetArmorSkills(), proto); }
+
+uint32 PlayerbotFactory::GetArmorSkills()
 {
-    if (proto->SubClass == ITEM_SUBCLASS_ARMOR_PLATE && !bot->HasSkill(SKILL_PLATE_MAIL))
-    {
-        return false;
-    }
-    if (proto->SubClass == ITEM_SUBCLASS_ARMOR_MAIL && !bot->HasSkill(SKILL_MAIL))
-    {
-        return false;
-    }
-    if (proto->SubClass == ITEM_SUBCLASS_ARMOR_LEATHER && !bot->HasSkill(SKILL_LEATHER))
-    {
-        return false;
-    }
-    if (proto->SubClass == ITEM_SUBCLASS_ARMOR_CLOTH && !bot->HasSkill(SKILL_CLOTH))
-    {
-        return false;
-    }
-    if (proto->SubClass == ITEM_SUBCLASS_ARMOR_SHIELD && !bot->HasSkill(SKILL_SHIELD))
-    {
-        return false;
-    }
+    uint32 armorSkills = 0;
+    if (bot->HasSkill(SKILL_PLATE_MAIL))
+        armorSkills |= 1 << ITEM_SUBCLASS_ARMOR_PLATE;
+    if (bot->HasSkill(SKILL_MAIL))
+        armorSkills |= 1 << ITEM_SUBCLASS_ARMOR_MAIL;
+    if (bot->HasSkill(SKILL_LEATHER))
+        armorSkills |= 1 << ITEM_SUBCLASS_ARMOR_LEATHER;
+    if (bot->HasSkill(SKILL_CLOTH))
+        armorSkills |= 1 << ITEM_SUBCLASS_ARMOR_CLOTH;
+    if (bot->HasSkill(SKILL_SHIELD))
+        armorSkills |= 1 << ITEM_SUBCLASS_ARMOR_SHIELD;
+
+    return armorSkills;
+}
 
-    return true;
+bool PlayerbotFactory::CanEquipArmor(uint32 armorSkills, ItemTemplate const* proto)
+{
+    switch (proto->SubClass)
+    {
+        case ITEM_SUBCLASS_ARMOR_PLATE:
+        case ITEM_SUBCLASS_ARMOR_MAIL:
+        case ITEM_SUBCLASS_ARMOR_LEATHER:
+        case ITEM_SUBCLASS_ARMOR_CLOTH:
+        case ITEM_SUBCLASS_ARMOR_SHIELD:
+            return armorSkills & (1 << proto->SubClass);
+        default:
+            return true;
+    }
     // for (uint8 slot = 0; slot < EQUIPMENT_SLOT_END; ++slot)
     // {
     //     if (slot == EQUIPMENT_SLOT_TABARD || slot == EQUIPMENT_SLOT_BODY)
@@ -1466,9 +1530,11 @@ void PlayerbotFactory::AddItemStats(uint32 mod, uint8& sp, uint8& ap, uint8& tan
     }
 }
 
-bool PlayerbotFactory::CanEquipWeapon(ItemTemplate const* proto)
+bool PlayerbotFactory::CanEquipWeapon(ItemTemplate const* proto) { return CanEquipWeapon(bot->getClass(), proto); }
+
+bool PlayerbotFactory::CanEquipWeapon(uint8 cls, ItemTemplate const* proto)
 {
-    switch (bot->getClass())
+    switch (cls)
     {
         case CLASS_PRIEST:
             if (proto->SubClass != ITEM_SUBCLASS_WEAPON_STAFF && proto->SubClass != ITEM_SUBCLASS_WEAPON_WAND &&
@@ -1709,90 +1775,61 @@ void PlayerbotFactory::InitEquipment(bool incremental, bool second_chance)
     if (incremental && !sPlayerbotAIConfig->incrementalGearInit)
         return;
 
-    if (level < 5)
-    {
-        // original items
-        if (CharStartOutfitEntry const* oEntry = GetCharStartOutfitEntry(bot->getRace(), bot->getClass(), bot->getGender()))
-        {
-            for (int j = 0; j < MAX_OUTFIT_ITEMS; ++j)
-            {
-                if (oEntry->ItemId[j] <= 0)
-                    continue;
+    PlayerbotFactoryPlan plan;
+    plan.input = GetPlanInput(incremental);
+    PlanEquipment(plan);
 
-                uint32 itemId = oEntry->ItemId[j];
+    InitEquipment(plan, second_chance);
+}
 
-                // skip hearthstone
-                if (itemId == 6948)
-                    continue;
+bool PlayerbotFactory::SkipEquipmentSlot(uint32 level, uint8 slot)
+{
+    if (slot == EQUIPMENT_SLOT_TABARD || slot == EQUIPMENT_SLOT_BODY)
+        return true;
 
-                // just skip, reported in ObjectMgr::LoadItemTemplates
-                ItemTemplate const* iProto = sObjectMgr->GetItemTemplate(itemId);
-                if (!iProto)
-                    continue;
+    if (level < 50 && (slot == EQUIPMENT_SLOT_TRINKET1 || slot == EQUIPMENT_SLOT_TRINKET2))
+        return true;
 
-                // BuyCount by default
-                uint32 count = iProto->BuyCount;
+    if (level < 30 && (slot == EQUIPMENT_SLOT_NECK || slot == EQUIPMENT_SLOT_HEAD))
+        return true;
 
-                // special amount for food/drink
-                if (iProto->Class == ITEM_CLASS_CONSUMABLE && iProto->SubClass == ITEM_SUBCLASS_FOOD)
-                {
-                    continue;
-                }
+    if (level < 20 && (slot == EQUIPMENT_SLOT_FINGER1 || slot == EQUIPMENT_SLOT_FINGER2))
+        return true;
 
-                if (bot->HasItemCount(itemId, count))
-                {
-                    continue;
-                }
+    if (level < 5 && (slot != EQUIPMENT_SLOT_MAINHAND) && (slot != EQUIPMENT_SLOT_OFFHAND) &&
+        (slot != EQUIPMENT_SLOT_FEET) && (slot != EQUIPMENT_SLOT_LEGS) && (slot != EQUIPMENT_SLOT_CHEST) &&
+        (slot != EQUIPMENT_SLOT_RANGED))
+        return true;
 
-                bot->StoreNewItemInBestSlots(itemId, count);
-            }
-        }
-        return;
-    }
+    return false;
+}
 
-    std::unordered_map<uint8, std::vector<uint32>> items;
-    // int tab = AiFactory::GetPlayerSpecTab(bot);
+void PlayerbotFactory::PlanEquipment(PlayerbotFactoryPlan& plan)
+{
+    PlayerbotFactoryPlanInput const& input = plan.input;
+    if (input.level < 5)
+        return;
 
-    uint32 blevel = bot->GetLevel();
-    int32 delta = std::min(blevel, 10u);
+    int32 delta = std::min(input.level, 10u);
 
-    StatsWeightCalculator calculator(bot);
+    StatsCollector collector(input.collectorType, input.cls);
+    // Weapons, rings and trinkets are candidates for two slots, collect their stats once
+    std::unordered_map<uint32, CollectedStats> collected;
     for (int32 slot : initSlotsOrder)
     {
-        if (slot == EQUIPMENT_SLOT_TABARD || slot == EQUIPMENT_SLOT_BODY)
-            continue;
-
-        if (level < 50 && (slot == EQUIPMENT_SLOT_TRINKET1 || slot == EQUIPMENT_SLOT_TRINKET2))
+        if (SkipEquipmentSlot(input.level, slot))
             continue;
 
-        if (level < 30 && (slot == EQUIPMENT_SLOT_NECK || slot == EQUIPMENT_SLOT_HEAD))
-            continue;
-
-        if (level < 20 && (slot == EQUIPMENT_SLOT_FINGER1 || slot == EQUIPMENT_SLOT_FINGER2))
-            continue;
+        std::vector<PlayerbotGearCandidate>& candidates = plan.gear[slot];
 
-        if (level < 5 && (slot != EQUIPMENT_SLOT_MAINHAND) && (slot != EQUIPMENT_SLOT_OFFHAND) &&
-            (slot != EQUIPMENT_SLOT_FEET) && (slot != EQUIPMENT_SLOT_LEGS) && (slot != EQUIPMENT_SLOT_CHEST) &&
-            (slot != EQUIPMENT_SLOT_RANGED))
-            continue;
-
-        Item* oldItem = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
-
-        if (second_chance && oldItem)
-        {
-            bot->DestroyItem(INVENTORY_SLOT_BAG_0, slot, true);
-        }
-
-        oldItem = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
-
-        int32 desiredQuality = itemQuality;
+        int32 desiredQuality = input.itemQuality;
         if (urand(0, 100) < 100 * sPlayerbotAIConfig->randomGearLoweringChance && desiredQuality > ITEM_QUALITY_NORMAL)
         {
             desiredQuality--;
         }
         do
         {
-            for (uint32 requiredLevel = bot->GetLevel(); requiredLevel > std::max((int32)bot->GetLevel() - delta, 0);
+            for (uint32 requiredLevel = input.level; requiredLevel > std::max((int32)input.level - delta, 0);
                  requiredLevel--)
             {
                 for (InventoryType inventoryType : GetPossibleInventoryTypeListBySlot((EquipmentSlots)slot))
@@ -1808,10 +1845,10 @@ void PlayerbotFactory::InitEquipment(bool incremental, bool second_chance)
                             continue;
 
                         // disable next expansion gear
-                        if (sPlayerbotAIConfig->limitGearExpansion && bot->GetLevel() <= 60 && itemId >= 23728)
+                        if (sPlayerbotAIConfig->limitGearExpansion && input.level <= 60 && itemId >= 23728)
                             continue;
 
-                        if (sPlayerbotAIConfig->limitGearExpansion && bot->GetLevel() <= 70 && itemId >= 35570 &&
+                        if (sPlayerbotAIConfig->limitGearExpansion && input.level <= 70 && itemId >= 35570 &&
                             itemId != 36737 && itemId != 37739 &&
                             itemId != 37740)  // transition point from TBC -> WOTLK isn't as clear, and there are other
                                               // wearable TBC items above 35570 but nothing of significance
@@ -1823,8 +1860,8 @@ void PlayerbotFactory::InitEquipment(bool incremental, bool second_chance)
 
                         bool shouldCheckGS = desiredQuality > ITEM_QUALITY_NORMAL;
 
-                        if (shouldCheckGS && gearScoreLimit != 0 &&
-                            CalcMixedGearScore(proto->ItemLevel, proto->Quality) > gearScoreLimit)
+                        if (shouldCheckGS && input.gearScoreLimit != 0 &&
+                            CalcMixedGearScore(proto->ItemLevel, proto->Quality) > input.gearScoreLimit)
                         {
                             continue;
                         }
@@ -1839,36 +1876,110 @@ void PlayerbotFactory::InitEquipment(bool incremental, bool second_chance)
                              slot == EQUIPMENT_SLOT_CHEST || slot == EQUIPMENT_SLOT_WAIST ||
                              slot == EQUIPMENT_SLOT_LEGS || slot == EQUIPMENT_SLOT_FEET ||
                              slot == EQUIPMENT_SLOT_WRISTS || slot == EQUIPMENT_SLOT_HANDS) &&
-                            !CanEquipArmor(proto))
+                            !CanEquipArmor(input.armorSkills, proto))
                             continue;
 
-                        if (proto->Class == ITEM_CLASS_WEAPON && !CanEquipWeapon(proto))
+                        if (proto->Class == ITEM_CLASS_WEAPON && !CanEquipWeapon(input.cls, proto))
                             continue;
 
-                        if (slot == EQUIPMENT_SLOT_OFFHAND && bot->getClass() == CLASS_ROGUE &&
+                        if (slot == EQUIPMENT_SLOT_OFFHAND && input.cls == CLASS_ROGUE &&
                             proto->Class != ITEM_CLASS_WEAPON)
                             continue;
-                        items[slot].push_back(itemId);
+
+                        auto stats = collected.find(itemId);
+                        if (stats == collected.end())
+                        {
+                            collector.Reset();
+                            collector.CollectItemStats(proto);
+                            stats = collected.emplace(itemId, CollectedStats()).first;
+                            std::copy(collector.stats, collector.stats + STATS_TYPE_MAX, stats->second.begin());
+                        }
+
+                        candidates.push_back({itemId, stats->second});
                     }
                 }
             }
-        } while (items[slot].size() < 25 && desiredQuality-- > ITEM_QUALITY_POOR);
+        } while (candidates.size() < 25 && desiredQuality-- > ITEM_QUALITY_POOR);
+    }
+}
 
-        std::vector<uint32>& ids = items[slot];
-        if (ids.empty())
+void PlayerbotFactory::InitEquipment(PlayerbotFactoryPlan const& plan, bool second_chance)
+{
+    bool const incremental = plan.input.incremental;
+    if (incremental && !sPlayerbotAIConfig->incrementalGearInit)
+        return;
+
+    if (level < 5)
+    {
+        // original items
+        if (CharStartOutfitEntry const* oEntry = GetCharStartOutfitEntry(bot->getRace(), bot->getClass(), bot->getGender()))
+        {
+            for (int j = 0; j < MAX_OUTFIT_ITEMS; ++j)
+            {
+                if (oEntry->ItemId[j] <= 0)
+                    continue;
+
+                uint32 itemId = oEntry->ItemId[j];
+
+                // skip hearthstone
+                if (itemId == 6948)
+                    continue;
+
+                // just skip, reported in ObjectMgr::LoadItemTemplates
+                ItemTemplate const* iProto = sObjectMgr->GetItemTemplate(itemId);
+                if (!iProto)
+                    continue;
+
+                // BuyCount by default
+                uint32 count = iProto->BuyCount;
+
+                // special amount for food/drink
+                if (iProto->Class == ITEM_CLASS_CONSUMABLE && iProto->SubClass == ITEM_SUBCLASS_FOOD)
+                {
+                    continue;
+                }
+
+                if (bot->HasItemCount(itemId, count))
+                {
+                    continue;
+                }
+
+                bot->StoreNewItemInBestSlots(itemId, count);
+            }
+        }
+        return;
+    }
+
+    StatsWeightCalculator calculator(bot);
+    for (int32 slot : initSlotsOrder)
+    {
+        if (SkipEquipmentSlot(level, slot))
+            continue;
+
+        Item* oldItem = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
+
+        if (second_chance && oldItem)
+        {
+            bot->DestroyItem(INVENTORY_SLOT_BAG_0, slot, true);
+        }
+
+        oldItem = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
+
+        auto candidates = plan.gear.find(slot);
+        if (candidates == plan.gear.end() || candidates->second.empty())
         {
             continue;
         }
 
         float bestScoreForSlot = -1;
         uint32 bestItemForSlot = 0;
-        for (int index = 0; index < ids.size(); index++)
+        for (PlayerbotGearCandidate const& candidate : candidates->second)
         {
-            uint32 newItemId = ids[index];
+            uint32 newItemId = candidate.itemId;
 
             ItemTemplate const* proto = sObjectMgr->GetItemTemplate(newItemId);
 
-            float cur_score = calculator.CalculateItem(newItemId);
+            float cur_score = calculator.CalculateCollectedItem(newItemId, candidate.stats);
             if (cur_score > bestScoreForSlot)
             {
                 // delay heavy check to here
@@ -1930,39 +2041,25 @@ void PlayerbotFactory::InitEquipment(bool incremental, bool second_chance)
     {
         for (int32 slot : initSlotsOrder)
         {
-            if (slot == EQUIPMENT_SLOT_TABARD || slot == EQUIPMENT_SLOT_BODY)
-                continue;
-
-            if (level < 50 && (slot == EQUIPMENT_SLOT_TRINKET1 || slot == EQUIPMENT_SLOT_TRINKET2))
-                continue;
-
-            if (level < 30 && (slot == EQUIPMENT_SLOT_NECK || slot == EQUIPMENT_SLOT_HEAD))
-                continue;
-
-            if (level < 20 && (slot == EQUIPMENT_SLOT_FINGER1 || slot == EQUIPMENT_SLOT_FINGER2))
-                continue;
-
-            if (level < 5 && (slot != EQUIPMENT_SLOT_MAINHAND) && (slot != EQUIPMENT_SLOT_OFFHAND) &&
-                (slot != EQUIPMENT_SLOT_FEET) && (slot != EQUIPMENT_SLOT_LEGS) && (slot != EQUIPMENT_SLOT_CHEST) &&
-                (slot != EQUIPMENT_SLOT_RANGED))
+            if (SkipEquipmentSlot(level, slot))
                 continue;
 
             if (Item* oldItem = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot))
                 bot->DestroyItem(INVENTORY_SLOT_BAG_0, slot, true);
 
-            std::vector<uint32>& ids = items[slot];
-            if (ids.empty())
+            auto candidates = plan.gear.find(slot);
+            if (candidates == plan.gear.end() || candidates->second.empty())
                 continue;
 
             float bestScoreForSlot = -1;
             uint32 bestItemForSlot = 0;
-            for (int index = 0; index < ids.size(); index++)
+            for (PlayerbotGearCandidate const& candidate : candidates->second)
             {
-                uint32 newItemId = ids[index];
+                uint32 newItemId = candidate.itemId;
 
                 ItemTemplate const* proto = sObjectMgr->GetItemTemplate(newItemId);
 
-                float cur_score = calculator.CalculateItem(newItemId);
+                float cur_score = calculator.CalculateCollectedItem(newItemId, candidate.stats);
                 if (cur_score > bestScoreForSlot)
                 {
                     // delay heavy check to here
@@ -4284,12 +4381,66 @@ void PlayerbotFactory::ApplyEnchantTemplate(uint8 spec)
 
 void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
 {
-    //int32 bestGemEnchantId[4] = {-1, -1, -1, -1};  // 1, 2, 4, 8 color //not used, line marked for removal.
-    //float bestGemScore[4] = {0, 0, 0, 0}; //not used, line marked for removal.
-    std::vector<uint32> curCount = GetCurrentGemsCount();
-    uint8 jewelersCount = 0;
-    int requiredActive = 2;
-    std::vector<uint32> availableGems;
+    PlayerbotFactoryPlan plan;
+    plan.input = GetPlanInput(false);
+    PlanEnchants(plan);
+
+    ApplyEnchantAndGemsNew(plan, destroyOld);
+}
+
+void PlayerbotFactory::PlanEnchants(PlayerbotFactoryPlan& plan)
+{
+    PlayerbotFactoryPlanInput const& input = plan.input;
+    StatsCollector collector(input.collectorType, input.cls);
+
+    for (const uint32& enchantSpell : enchantSpellIdCache)
+    {
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(enchantSpell);
+        if (!spellInfo)
+            continue;
+
+        uint32 requiredLevel = spellInfo->BaseLevel;
+        if (requiredLevel > input.level)
+        {
+            continue;
+        }
+
+        // disable next expansion enchantments
+        if (sPlayerbotAIConfig->limitEnchantExpansion && input.level <= 60 && enchantSpell >= 27899)
+            continue;
+
+        if (sPlayerbotAIConfig->limitEnchantExpansion && input.level <= 70 && enchantSpell >= 44483)
+            continue;
+
+        for (uint8 j = 0; j < MAX_SPELL_EFFECTS; ++j)
+        {
+            if (spellInfo->Effects[j].Effect != SPELL_EFFECT_ENCHANT_ITEM)
+                continue;
+
+            uint32 enchant_id = spellInfo->Effects[j].MiscValue;
+            if (!enchant_id)
+                continue;
+
+            SpellItemEnchantmentEntry const* enchant = sSpellItemEnchantmentStore.LookupEntry(enchant_id);
+            if (!enchant || (enchant->slot != PERM_ENCHANTMENT_SLOT && enchant->slot != TEMP_ENCHANTMENT_SLOT))
+            {
+                continue;
+            }
+            if (enchant->requiredLevel > input.level)
+            {
+                continue;
+            }
+
+            PlayerbotEnchantCandidate candidate;
+            candidate.spellId = enchantSpell;
+            candidate.enchantId = enchant_id;
+            collector.Reset();
+            collector.CollectEnchantStats(enchant);
+            std::copy(collector.stats, collector.stats + STATS_TYPE_MAX, candidate.stats.begin());
+            plan.enchants.push_back(candidate);
+        }
+    }
+
     for (const uint32& enchantGem : enchantGemIdCache)
     {
         ItemTemplate const* gemTemplate = sObjectMgr->GetItemTemplate(enchantGem);
@@ -4300,12 +4451,12 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
         if (!gemProperties)
             continue;
 
-        if (sPlayerbotAIConfig->limitEnchantExpansion && bot->GetLevel() <= 70 && enchantGem >= 39900)
+        if (sPlayerbotAIConfig->limitEnchantExpansion && input.level <= 70 && enchantGem >= 39900)
             continue;
 
         uint32 requiredLevel = gemTemplate->ItemLevel;
 
-        if (requiredLevel > bot->GetLevel())
+        if (requiredLevel > input.level)
         {
             continue;
         }
@@ -4319,16 +4470,38 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
         {
             continue;
         }
-        if (enchant->requiredSkill && bot->GetSkillValue(enchant->requiredSkill) < enchant->requiredSkillValue)
+
+        if (enchant->requiredLevel > input.level)
         {
             continue;
         }
 
-        if (enchant->requiredLevel > bot->GetLevel())
+        PlayerbotGemCandidate candidate;
+        candidate.itemId = enchantGem;
+        candidate.enchantId = enchant_id;
+        collector.Reset();
+        collector.CollectEnchantStats(enchant);
+        std::copy(collector.stats, collector.stats + STATS_TYPE_MAX, candidate.stats.begin());
+        plan.gems.push_back(candidate);
+    }
+}
+
+void PlayerbotFactory::ApplyEnchantAndGemsNew(PlayerbotFactoryPlan const& plan, bool /*destroyOld*/)
+{
+    //int32 bestGemEnchantId[4] = {-1, -1, -1, -1};  // 1, 2, 4, 8 color //not used, line marked for removal.
+    //float bestGemScore[4] = {0, 0, 0, 0}; //not used, line marked for removal.
+    std::vector<uint32> curCount = GetCurrentGemsCount();
+    uint8 jewelersCount = 0;
+    int requiredActive = 2;
+    std::vector<PlayerbotGemCandidate const*> availableGems;
+    for (PlayerbotGemCandidate const& gem : plan.gems)
+    {
+        SpellItemEnchantmentEntry const* enchant = sSpellItemEnchantmentStore.LookupEntry(gem.enchantId);
+        if (enchant->requiredSkill && bot->GetSkillValue(enchant->requiredSkill) < enchant->requiredSkillValue)
         {
             continue;
         }
-        availableGems.push_back(enchantGem);
+        availableGems.push_back(&gem);
     }
     StatsWeightCalculator calculator(bot);
     for (uint8 slot = 0; slot < EQUIPMENT_SLOT_END; ++slot)
@@ -4345,60 +4518,26 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
             continue;
         int32 bestEnchantId = -1;
         float bestScore = 0;
-        for (const uint32& enchantSpell : enchantSpellIdCache)
+        for (PlayerbotEnchantCandidate const& candidate : plan.enchants)
         {
-            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(enchantSpell);
-            if (!spellInfo)
-                continue;
-
+            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(candidate.spellId);
             if (!item->IsFitToSpellRequirements(spellInfo))
             {
                 continue;
             }
 
-            uint32 requiredLevel = spellInfo->BaseLevel;
-            if (requiredLevel > bot->GetLevel())
+            SpellItemEnchantmentEntry const* enchant = sSpellItemEnchantmentStore.LookupEntry(candidate.enchantId);
+            if (enchant->requiredSkill &&
+                (!bot->HasSkill(enchant->requiredSkill) ||
+                 (bot->GetSkillValue(enchant->requiredSkill) < enchant->requiredSkillValue)))
             {
                 continue;
             }
-
-            // disable next expansion enchantments
-            if (sPlayerbotAIConfig->limitEnchantExpansion && bot->GetLevel() <= 60 && enchantSpell >= 27899)
-                continue;
-
-            if (sPlayerbotAIConfig->limitEnchantExpansion && bot->GetLevel() <= 70 && enchantSpell >= 44483)
-                continue;
-
-            for (uint8 j = 0; j < MAX_SPELL_EFFECTS; ++j)
+            float score = calculator.CalculateCollectedEnchant(candidate.stats);
+            if (score >= bestScore)
             {
-                if (spellInfo->Effects[j].Effect != SPELL_EFFECT_ENCHANT_ITEM)
-                    continue;
-
-                uint32 enchant_id = spellInfo->Effects[j].MiscValue;
-                if (!enchant_id)
-                    continue;
-
-                SpellItemEnchantmentEntry const* enchant = sSpellItemEnchantmentStore.LookupEntry(enchant_id);
-                if (!enchant || (enchant->slot != PERM_ENCHANTMENT_SLOT && enchant->slot != TEMP_ENCHANTMENT_SLOT))
-                {
-                    continue;
-                }
-                if (enchant->requiredSkill &&
-                    (!bot->HasSkill(enchant->requiredSkill) ||
-                     (bot->GetSkillValue(enchant->requiredSkill) < enchant->requiredSkillValue)))
-                {
-                    continue;
-                }
-                if (enchant->requiredLevel > bot->GetLevel())
-                {
-                    continue;
-                }
-                float score = calculator.CalculateEnchant(enchant_id);
-                if (score >= bestScore)
-                {
-                    bestScore = score;
-                    bestEnchantId = enchant_id;
-                }
+                bestScore = score;
+                bestEnchantId = candidate.enchantId;
             }
         }
         // enchant item
@@ -4422,11 +4561,9 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
             int32 colorChosen;
             bool jewelersGemChosen;
             float bestGemScore = -1;
-            for (uint32& enchantGem : availableGems)
+            for (PlayerbotGemCandidate const* gem : availableGems)
             {
-                ItemTemplate const* gemTemplate = sObjectMgr->GetItemTemplate(enchantGem);
-                if (!gemTemplate)
-                    continue;
+                ItemTemplate const* gemTemplate = sObjectMgr->GetItemTemplate(gem->itemId);
 
                 // Limit jewelers (JC) epic gems to 3
                 bool isJewelersGem = gemTemplate->ItemLimitCategory == 2;
@@ -4434,19 +4571,10 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
                     continue;
 
                 const GemPropertiesEntry* gemProperties = sGemPropertiesStore.LookupEntry(gemTemplate->GemProperties);
-                if (!gemProperties)
-                    continue;
-
                 if ((socketColor & gemProperties->color) == 0 && gemProperties->color == 1)  // meta socket
                     continue;
 
-                uint32 enchant_id = gemProperties->spellitemenchantement;
-                if (!enchant_id)
-                    continue;
-
-                //SpellItemEnchantmentEntry const* enchant = sSpellItemEnchantmentStore.LookupEntry(enchant_id); //not used, line marked for removal.
-                StatsWeightCalculator calculator(bot);
-                float score = calculator.CalculateEnchant(enchant_id);
+                float score = calculator.CalculateCollectedEnchant(gem->stats);
                 if (curCount[0] != 0)
                 {
                     // Ensure meta gem activation
@@ -4463,7 +4591,7 @@ void PlayerbotFactory::ApplyEnchantAndGemsNew(bool destroyOld)
                     score *= 1.2;
                 if (score > bestGemScore)
                 {
-                    enchantIdChosen = enchant_id;
+                    enchantIdChosen = gem->enchantId;
                     colorChosen = gemProperties->color;
                     bestGemScore = score;
                     jewelersGemChosen = isJewelersGem;
@@ -9,6 +9,7 @@
 #include "InventoryAction.h"
 #include "Player.h"
 #include "PlayerbotAI.h"
+#include "PlayerbotFactoryPlanner.h"
 
 class Item;
 
@@ -54,6 +55,13 @@ public:
     static void Init();
     void Refresh();
     void Randomize(bool incremental);
+    // Same as Randomize, but gear and enchants are planned by sPlayerbotFactoryPlanner and applied on a later update
+    void RandomizeAsync(bool incremental);
+    PlayerbotFactoryPlanInput GetPlanInput(bool incremental);
+    // Thread safe, reads only the input and static item, spell and enchant data
+    static PlayerbotFactoryPlan Plan(PlayerbotFactoryPlanInput const& input);
+    // Everything Randomize does after mounts: equipment, enchants, consumables, glyphs, guild, pet
+    void ApplyPlan(PlayerbotFactoryPlan const& plan);
     static std::list<uint32> classQuestIds;
     void ClearEverything();
     void InitSkills();
@@ -67,6 +75,7 @@ public:
     void InitClassSpells();
     void InitSpecialSpells();
     void InitEquipment(bool incremental, bool second_chance = false);
+    void InitEquipment(PlayerbotFactoryPlan const& plan, bool second_chance = false);
     void InitPet();
     void InitAmmo();
     static uint32 CalcMixedGearScore(uint32 gs, uint32 quality);
@@ -80,6 +89,7 @@ public:
     void InitMounts();
     void InitBags(bool destroyOld = true);
     void ApplyEnchantAndGemsNew(bool destroyOld = true);
+    void ApplyEnchantAndGemsNew(PlayerbotFactoryPlan const& plan, bool destroyOld = true);
     void InitInstanceQuests();
     void UnbindInstance();
     void InitKeyring();
@@ -88,6 +98,10 @@ public:
 
 private:
     void Prepare();
+    void RandomizeBeforeEquipment(bool incremental);
+    static void PlanEquipment(PlayerbotFactoryPlan& plan);
+    static void PlanEnchants(PlayerbotFactoryPlan& plan);
+    static bool SkipEquipmentSlot(uint32 level, uint8 slot);
     // void InitSecondEquipmentSet();
     // void InitEquipmentNew(bool incremental);
     bool CanEquipItem(ItemTemplate const* proto);
@@ -107,6 +121,9 @@ private:
     std::vector<uint32> GetCurrentGemsCount();
     bool CanEquipArmor(ItemTemplate const* proto);
     bool CanEquipWeapon(ItemTemplate const* proto);
+    static bool CanEquipArmor(uint32 armorSkills, ItemTemplate const* proto);
+    static bool CanEquipWeapon(uint8 cls, ItemTemplate const* proto);
+    uint32 GetArmorSkills();
     void EnchantItem(Item* item);
     void AddItemStats(uint32 mod, uint8& sp, uint8& ap, uint8& tank);
     bool CheckItemStats(uint8 sp, uint8 ap, uint8 tank);
@@ -124,7 +141,7 @@ private:
     void LoadEnchantContainer();
     void ApplyEnchantTemplate();
     void ApplyEnchantTemplate(uint8 spec);
-    std::vector<InventoryType> GetPossibleInventoryTypeListBySlot(EquipmentSlots slot);
+    static std::vector<InventoryType> GetPossibleInventoryTypeListBySlot(EquipmentSlots slot);
     void IterateItems(IterateItemsVisitor* visitor, IterateItemsMask mask = ITERATE_ITEMS_IN_BAGS);
     void IterateItemsInBags(IterateItemsVisitor* visitor);
     void IterateItemsInEquip(IterateItemsVisitor* visitor);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotFactoryPlanner.h"
+
+#include "Log.h"
+#include "ObjectAccessor.h"
+#include "PlayerbotFactory.h"
+#include "Playerbots.h"
+#include "Timer.h"
+
+PlayerbotFactoryPlanner::~PlayerbotFactoryPlanner() { Stop(); }
+
+void PlayerbotFactoryPlanner::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+
+    queued.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+
+    workers.clear();
+}
+
+bool PlayerbotFactoryPlanner::Submit(PlayerbotFactoryPlanInput const& input)
+{
+    if (!sPlayerbotAIConfig->randomizePlanThreads)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping)
+            return false;
+
+        if (workers.empty())
+            for (uint32 i = 0; i < sPlayerbotAIConfig->randomizePlanThreads; ++i)
+                workers.emplace_back(&PlayerbotFactoryPlanner::Work, this);
+
+        PlayerbotFactoryPlanInput& submitted = pending[input.guid];
+        submitted = input;
+        submitted.sequence = ++lastSequence;
+        inputs.push_back(submitted);
+    }
+
+    queued.notify_one();
+    return true;
+}
+
+void PlayerbotFactoryPlanner::Cancel(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    pending.erase(guid);
+}
+
+void PlayerbotFactoryPlanner::Work()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        queued.wait(guard, [&]() { return stopping || !inputs.empty(); });
+        if (stopping)
+            return;
+
+        PlayerbotFactoryPlanInput const input = inputs.front();
+        inputs.pop_front();
+
+        guard.unlock();
+        uint32 const planStart = getMSTime();
+        PlayerbotFactoryPlan plan = PlayerbotFactory::Plan(input);
+        LOG_DEBUG("playerbots", "Planned gear for bot {} (level {}) in {} ms", input.guid.ToString(), input.level,
+                  GetMSTimeDiffToNow(planStart));
+        guard.lock();
+
+        plans.push_back(std::move(plan));
+    }
+}
+
+void PlayerbotFactoryPlanner::Update()
+{
+    for (uint32 i = 0; i < MAX_APPLIES_PER_UPDATE; ++i)
+    {
+        PlayerbotFactoryPlan plan;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (plans.empty())
+                return;
+
+            plan = std::move(plans.front());
+            plans.pop_front();
+
+            // Cancelled, applied at logout or superseded by a later submit
+            auto itr = pending.find(plan.input.guid);
+            if (itr == pending.end() || itr->second.sequence != plan.input.sequence)
+                continue;
+
+            pending.erase(itr);
+        }
+
+        Player* bot = ObjectAccessor::FindPlayer(plan.input.guid);
+        if (bot && GET_PLAYERBOT_AI(bot))
+        {
+            PlayerbotFactory factory(bot, bot->GetLevel(), plan.input.itemQuality, plan.input.gearScoreLimit);
+
+            // Leveled or respecced while the plan was built, the candidates are for the old state
+            PlayerbotFactoryPlanInput const input = factory.GetPlanInput(plan.input.incremental);
+            if (input.level != plan.input.level || input.collectorType != plan.input.collectorType ||
+                input.armorSkills != plan.input.armorSkills)
+                plan = PlayerbotFactory::Plan(input);
+
+            factory.ApplyPlan(plan);
+        }
+    }
+}
+
+void PlayerbotFactoryPlanner::OnLogout(Player* bot)
+{
+    PlayerbotFactoryPlanInput queued;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto itr = pending.find(bot->GetGUID());
+        if (itr == pending.end())
+            return;
+
+        queued = itr->second;
+        pending.erase(itr);
+    }
+
+    PlayerbotFactory factory(bot, bot->GetLevel(), queued.itemQuality, queued.gearScoreLimit);
+    factory.ApplyPlan(PlayerbotFactory::Plan(factory.GetPlanInput(queued.incremental)));
+    LOG_DEBUG("playerbots", "Applied queued gear plan for bot {} at logout", bot->GetName());
+}
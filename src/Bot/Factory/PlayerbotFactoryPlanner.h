@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTFACTORYPLANNER_H
+#define _PLAYERBOT_PLAYERBOTFACTORYPLANNER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "StatsCollector.h"
+
+class Player;
+
+// Everything the gear and enchant plan depends on, copied from the bot on its own thread. Planning never touches
+// the Player, only these values and the static item, spell and enchant data.
+struct PlayerbotFactoryPlanInput
+{
+    ObjectGuid guid;
+    uint8 cls = 0;
+    uint32 level = 0;
+    uint32 itemQuality = 0;
+    uint32 gearScoreLimit = 0;
+    CollectorType collectorType = CollectorType::MELEE_DMG;
+    uint32 armorSkills = 0;  // 1 << ITEM_SUBCLASS_ARMOR_* for the armor skills the bot has
+    bool incremental = false;
+    bool planGear = false;
+    bool planEnchants = false;
+    uint32 sequence = 0;  // set by Submit, a plan is only applied while it is the bot's latest submit
+};
+
+struct PlayerbotGearCandidate
+{
+    uint32 itemId;
+    CollectedStats stats;
+};
+
+struct PlayerbotEnchantCandidate
+{
+    uint32 spellId;
+    uint32 enchantId;
+    CollectedStats stats;
+};
+
+struct PlayerbotGemCandidate
+{
+    uint32 itemId;
+    uint32 enchantId;
+    CollectedStats stats;
+};
+
+// Candidates that passed every check not depending on the Player, with their stats already collected. Applying
+// the plan only weighs these stats and runs the checks that need the Player (skills, items owned, free slots).
+struct PlayerbotFactoryPlan
+{
+    PlayerbotFactoryPlanInput input;
+    std::unordered_map<uint8, std::vector<PlayerbotGearCandidate>> gear;  // equipment slot -> candidates
+    std::vector<PlayerbotEnchantCandidate> enchants;
+    std::vector<PlayerbotGemCandidate> gems;
+};
+
+// Builds PlayerbotFactory plans on worker threads (AiPlayerbot.RandomizePlanThreads) and hands them back to the
+// world thread, where Update applies them to the bots that are still online.
+class PlayerbotFactoryPlanner
+{
+public:
+    PlayerbotFactoryPlanner() {}
+    virtual ~PlayerbotFactoryPlanner();
+    static PlayerbotFactoryPlanner* instance()
+    {
+        static PlayerbotFactoryPlanner instance;
+        return &instance;
+    }
+
+    // False when planning off-thread is disabled or stopped, the caller plans and applies on its own. Replaces a
+    // plan still queued for the bot.
+    bool Submit(PlayerbotFactoryPlanInput const& input);
+    // Drops the bot's queued plan, a plan the workers are still building is skipped when it comes back
+    void Cancel(ObjectGuid guid);
+    // World thread only
+    void Update();
+    // Applies the bot's queued plan right away, so it is saved with its gear instead of stripped. World thread only
+    void OnLogout(Player* bot);
+    // Joins the workers while the data they read still exists; queued plans are applied at logout instead
+    void Stop();
+
+private:
+    static uint32 const MAX_APPLIES_PER_UPDATE = 5;
+
+    void Work();
+
+    std::mutex lock;
+    std::condition_variable queued;
+    std::deque<PlayerbotFactoryPlanInput> inputs;
+    std::deque<PlayerbotFactoryPlan> plans;
+    std::unordered_map<ObjectGuid, PlayerbotFactoryPlanInput> pending;  // latest submit not applied yet
+    uint32 lastSequence = 0;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+#define sPlayerbotFactoryPlanner PlayerbotFactoryPlanner::instance()
+
+#endif
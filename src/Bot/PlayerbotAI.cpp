@@ -40,7 +40,9 @@
 #include "ObjectMgr.h"
 #include "PerfMonitor.h"
 #include "Player.h"
+#include "PlayerbotActivityGovernor.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotGearScoreCache.h"
 #include "PlayerbotRepository.h"
 #include "PlayerbotMgr.h"
 #include "PlayerbotGuildMgr.h"
@@ -261,6 +263,15 @@ void PlayerbotAI::UpdateAI(uint32 elapsed, bool minimal)
             bot->SetPower(bot->getPowerType(), bot->GetMaxPower(bot->getPowerType()));
     }
 
+    // Thin or skip ticks of bots the activity governor moved out of the full tier
+    if (activityTier != BOT_ACTIVITY_TIER_FULL && !bot->IsInCombat() && sPlayerbotActivityGovernor->IsEnabled())
+    {
+        governorElapsed += elapsed;
+        if (governorElapsed < sPlayerbotActivityGovernor->GetTickInterval(activityTier))
+            return;
+    }
+    governorElapsed = 0;
+
     AllowActivity();
 
     if (!CanUpdateAI())
@@ -440,6 +451,9 @@ void PlayerbotAI::UpdateAIInternal([[maybe_unused]] uint32 elapsed, bool minimal
     if (!bot || bot->IsBeingTeleported() || !bot->IsInWorld())
         return;
 
+    // Start of the tick, no value pointers are held yet
+    aiObjectContext->TrimValues();
+
     std::string const mapString = WorldPosition(bot).isOverworld() ? std::to_string(bot->GetMapId()) : "I";
     PerfMonitorOperation* pmo =
         sPerfMonitor->start(PERF_MON_TOTAL, "PlayerbotAI::UpdateAIInternal " + mapString);
@@ -902,57 +916,30 @@ bool PlayerbotAI::IsAllowedCommand(std::string const text)
 
 void PlayerbotAI::HandleCommand(uint32 type, std::string const text, Player* fromPlayer)
 {
-    if (!GetSecurity()->CheckLevelFor(PLAYERBOT_SECURITY_INVITE, type != CHAT_MSG_WHISPER, fromPlayer))
-        return;
-
-    if (type == CHAT_MSG_ADDON)
-        return;
+    HandleCommand(ChatCommandMessage(type, text), fromPlayer);
+}
 
-    if (type == CHAT_MSG_SYSTEM)
+void PlayerbotAI::HandleCommand(ChatCommandMessage const& message, Player* fromPlayer)
+{
+    if (message.IsEmpty())
         return;
 
-    if (text.find(sPlayerbotAIConfig->commandSeparator) != std::string::npos)
-    {
-        std::vector<std::string> commands;
-        split(commands, text, sPlayerbotAIConfig->commandSeparator.c_str());
-        for (std::vector<std::string>::iterator i = commands.begin(); i != commands.end(); ++i)
-        {
-            HandleCommand(type, *i, fromPlayer);
-        }
-
+    uint32 const type = message.GetType();
+    if (!GetSecurity()->CheckLevelFor(PLAYERBOT_SECURITY_INVITE, type != CHAT_MSG_WHISPER, fromPlayer))
         return;
-    }
 
-    std::string filtered = text;
-    if (!sPlayerbotAIConfig->commandPrefix.empty())
-    {
-        if (filtered.find(sPlayerbotAIConfig->commandPrefix) != 0)
-            return;
-
-        filtered = filtered.substr(sPlayerbotAIConfig->commandPrefix.size());
-    }
-
-    if (chatMap.empty())
-    {
-        chatMap["#w "] = CHAT_MSG_WHISPER;
-        chatMap["#p "] = CHAT_MSG_PARTY;
-        chatMap["#r "] = CHAT_MSG_RAID;
-        chatMap["#a "] = CHAT_MSG_ADDON;
-        chatMap["#g "] = CHAT_MSG_GUILD;
-    }
+    for (ParsedChatCommand const& command : message.GetCommands())
+        HandleParsedCommand(type, command, fromPlayer);
+}
 
+void PlayerbotAI::HandleParsedCommand(uint32 type, ParsedChatCommand const& command, Player* fromPlayer)
+{
     currentChat = std::pair<ChatMsg, time_t>(CHAT_MSG_WHISPER, 0);
-    for (std::map<std::string, ChatMsg>::iterator i = chatMap.begin(); i != chatMap.end(); ++i)
-    {
-        if (filtered.find(i->first) == 0)
-        {
-            filtered = filtered.substr(3);
-            currentChat = std::pair<ChatMsg, time_t>(i->second, time(nullptr) + 2);
-            break;
-        }
-    }
+    if (command.redirected)
+        currentChat = std::pair<ChatMsg, time_t>(command.replyChat, time(nullptr) + 2);
 
-    filtered = chatFilter.Filter(trim(filtered));
+    std::string filtered = command.text;
+    filtered = chatFilter.Filter(filtered);
     if (filtered.empty())
         return;
 
@@ -1740,35 +1727,7 @@ bool PlayerbotAI::IsRanged(Player* player, bool bySpec)
     if (!bySpec && botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_RANGED);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
-    switch (player->getClass())
-    {
-        case CLASS_DEATH_KNIGHT:
-        case CLASS_WARRIOR:
-        case CLASS_ROGUE:
-            return false;
-            break;
-        case CLASS_DRUID:
-            if (tab == 1)
-            {
-                return false;
-            }
-            break;
-        case CLASS_PALADIN:
-            if (tab != 0)
-            {
-                return false;
-            }
-            break;
-        case CLASS_SHAMAN:
-            if (tab == 1)
-            {
-                return false;
-            }
-            break;
-    }
-
-    return true;
+    return AiFactory::GetPlayerRoleProfile(player).roles & SPEC_ROLE_RANGED;
 }
 
 bool PlayerbotAI::IsMelee(Player* player, bool bySpec) { return !IsRanged(player, bySpec); }
@@ -2067,36 +2026,17 @@ bool PlayerbotAI::IsTank(Player* player, bool bySpec)
     if (!bySpec && botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_TANK);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
-    switch (player->getClass())
-    {
-        case CLASS_DEATH_KNIGHT:
-            if (tab == DEATH_KNIGHT_TAB_BLOOD)
-            {
-                return true;
-            }
-            break;
-        case CLASS_PALADIN:
-            if (tab == PALADIN_TAB_PROTECTION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_WARRIOR:
-            if (tab == WARRIOR_TAB_PROTECTION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_DRUID:
-            if (tab == DRUID_TAB_FERAL && (player->GetShapeshiftForm() == FORM_BEAR ||
-                                           player->GetShapeshiftForm() == FORM_DIREBEAR || player->HasAura(16931)))
-            {
-                return true;
-            }
-            break;
-    }
-    return false;
+    uint8 const roles = AiFactory::GetPlayerRoleProfile(player).roles;
+    if (roles & SPEC_ROLE_FERAL)
+        return IsFeralTank(player);
+
+    return roles & SPEC_ROLE_TANK;
+}
+
+bool PlayerbotAI::IsFeralTank(Player* player)
+{
+    return player->GetShapeshiftForm() == FORM_BEAR || player->GetShapeshiftForm() == FORM_DIREBEAR ||
+           player->HasAura(16931);
 }
 
 bool PlayerbotAI::IsHeal(Player* player, bool bySpec)
@@ -2105,35 +2045,7 @@ bool PlayerbotAI::IsHeal(Player* player, bool bySpec)
     if (!bySpec && botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_HEAL);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
-    switch (player->getClass())
-    {
-        case CLASS_PRIEST:
-            if (tab == PRIEST_TAB_DISCIPLINE || tab == PRIEST_TAB_HOLY)
-            {
-                return true;
-            }
-            break;
-        case CLASS_DRUID:
-            if (tab == DRUID_TAB_RESTORATION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_SHAMAN:
-            if (tab == SHAMAN_TAB_RESTORATION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_PALADIN:
-            if (tab == PALADIN_TAB_HOLY)
-            {
-                return true;
-            }
-            break;
-    }
-    return false;
+    return AiFactory::GetPlayerRoleProfile(player).roles & SPEC_ROLE_HEAL;
 }
 
 bool PlayerbotAI::IsDps(Player* player, bool bySpec)
@@ -2142,56 +2054,11 @@ bool PlayerbotAI::IsDps(Player* player, bool bySpec)
     if (!bySpec && botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_DPS);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
-    switch (player->getClass())
-    {
-        case CLASS_MAGE:
-        case CLASS_WARLOCK:
-        case CLASS_HUNTER:
-        case CLASS_ROGUE:
-            return true;
-        case CLASS_PRIEST:
-            if (tab == PRIEST_TAB_SHADOW)
-            {
-                return true;
-            }
-            break;
-        case CLASS_DRUID:
-            if (tab == DRUID_TAB_BALANCE)
-            {
-                return true;
-            }
-            if (tab == DRUID_TAB_FERAL && !IsTank(player, bySpec))
-            {
-                return true;
-            }
-            break;
-        case CLASS_SHAMAN:
-            if (tab != SHAMAN_TAB_RESTORATION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_PALADIN:
-            if (tab == PALADIN_TAB_RETRIBUTION)
-            {
-                return true;
-            }
-            break;
-        case CLASS_DEATH_KNIGHT:
-            if (tab != DEATH_KNIGHT_TAB_BLOOD)
-            {
-                return true;
-            }
-            break;
-        case CLASS_WARRIOR:
-            if (tab != WARRIOR_TAB_PROTECTION)
-            {
-                return true;
-            }
-            break;
-    }
-    return false;
+    uint8 const roles = AiFactory::GetPlayerRoleProfile(player).roles;
+    if (roles & SPEC_ROLE_FERAL)
+        return !IsFeralTank(player);
+
+    return roles & SPEC_ROLE_DPS;
 }
 
 bool PlayerbotAI::IsMainTank(Player* player)
@@ -2202,23 +2069,22 @@ bool PlayerbotAI::IsMainTank(Player* player)
         return IsTank(player);
     }
 
-    ObjectGuid mainTank = ObjectGuid();
+    ObjectGuid mainTank = GetMainTankGuid(group);
+    return mainTank && player->GetGUID() == mainTank;
+}
+
+ObjectGuid PlayerbotAI::GetMainTankGuid(Group* group)
+{
     Group::MemberSlotList const& slots = group->GetMemberSlots();
 
     for (Group::member_citerator itr = slots.begin(); itr != slots.end(); ++itr)
     {
         if (itr->flags & MEMBER_FLAG_MAINTANK)
         {
-            mainTank = itr->guid;
-            break;
+            return itr->guid;
         }
     }
 
-    if (mainTank != ObjectGuid::Empty)
-    {
-        return player->GetGUID() == mainTank;
-    }
-
     for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
     {
         Player* member = ref->GetSource();
@@ -2229,11 +2095,11 @@ bool PlayerbotAI::IsMainTank(Player* player)
 
         if (IsTank(member) && member->IsAlive())
         {
-            return player->GetGUID() == member->GetGUID();
+            return member->GetGUID();
         }
     }
 
-    return false;
+    return ObjectGuid::Empty;
 }
 
 bool PlayerbotAI::IsBotMainTank(Player* player)
@@ -2324,6 +2190,8 @@ bool PlayerbotAI::IsAssistTankOfIndex(Player* player, int index, bool ignoreDead
     {
         return false;
     }
+    // Same main tank for every member, look it up once instead of once per member
+    ObjectGuid mainTank = GetMainTankGuid(group);
     int counter = 0;
     for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
     {
@@ -2337,7 +2205,7 @@ bool PlayerbotAI::IsAssistTankOfIndex(Player* player, int index, bool ignoreDead
         if (ignoreDeadPlayers && !member->IsAlive())
             continue;
 
-        if (group->IsAssistant(member->GetGUID()) && IsAssistTank(member))
+        if (group->IsAssistant(member->GetGUID()) && IsTank(member) && member->GetGUID() != mainTank)
         {
             if (index == counter)
             {
@@ -2359,7 +2227,7 @@ bool PlayerbotAI::IsAssistTankOfIndex(Player* player, int index, bool ignoreDead
         if (ignoreDeadPlayers && !member->IsAlive())
             continue;
 
-        if (!group->IsAssistant(member->GetGUID()) && IsAssistTank(member))
+        if (!group->IsAssistant(member->GetGUID()) && IsTank(member) && member->GetGUID() != mainTank)
         {
             if (index == counter)
             {
@@ -4464,7 +4332,8 @@ bool PlayerbotAI::AllowActive(ActivityType activityType)
         return false;
 
     // when botActiveAlone is 100% and smartScale disabled
-    if (sPlayerbotAIConfig->botActiveAlone >= 100 && !sPlayerbotAIConfig->botActiveAloneSmartScale)
+    if (sPlayerbotAIConfig->botActiveAlone >= 100 && !sPlayerbotAIConfig->botActiveAloneSmartScale &&
+        !sPlayerbotActivityGovernor->IsEnabled())
     {
         return true;
     }
@@ -4651,6 +4520,12 @@ bool PlayerbotAI::AllowActive(ActivityType activityType)
     // situations are usable for scaling when enabled.
     // #######################################################################################
 
+    // The governor already ranked this bot against all others and holds the world diff around its target.
+    if (sPlayerbotActivityGovernor->IsEnabled())
+    {
+        return activityTier != BOT_ACTIVITY_TIER_DORMANT;
+    }
+
     // Below is code to have a specified % of bots active at all times.
     // The default is 100%. With 1% of all bots going active or inactive each minute.
     uint32 mod = sPlayerbotAIConfig->botActiveAlone > 100 ? 100 : sPlayerbotAIConfig->botActiveAlone;
@@ -4894,6 +4769,11 @@ uint32 PlayerbotAI::GetEquipGearScore(Player* player)
     return 0;
 }*/
 uint32 PlayerbotAI::GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN)
+{
+    return sPlayerbotGearScoreCache->Get(player, withBags, withBank, topN);
+}
+
+uint32 PlayerbotAI::CalculateMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN)
 {
     std::vector<uint32> gearScore(EQUIPMENT_SLOT_END);
     uint32 twoHandScore = 0;
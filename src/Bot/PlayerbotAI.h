@@ -10,6 +10,7 @@
 #include <stack>
 
 #include "Chat.h"
+#include "ChatCommandMessage.h"
 #include "ChatFilter.h"
 #include "ChatHelper.h"
 #include "Common.h"
@@ -30,6 +31,7 @@ class AiObjectContext;
 class Creature;
 class Engine;
 class ExternalEventHelper;
+class Group;
 class Gameobject;
 class Item;
 class ObjectGuid;
@@ -266,6 +268,16 @@ enum ActivityType
     MAX_ACTIVITY_TYPE
 };
 
+// Published by PlayerbotActivityGovernor, thins or skips AI ticks of less important bots.
+enum BotActivityTier : uint8
+{
+    BOT_ACTIVITY_TIER_FULL = 0,
+    BOT_ACTIVITY_TIER_REDUCED = 1,
+    BOT_ACTIVITY_TIER_DORMANT = 2,
+
+    BOT_ACTIVITY_TIER_MAX
+};
+
 enum BotRoles : uint8
 {
     BOT_ROLE_NONE = 0x00,
@@ -393,6 +405,7 @@ public:
 
     std::string const HandleRemoteCommand(std::string const command);
     void HandleCommand(uint32 type, std::string const text, Player* fromPlayer);
+    void HandleCommand(ChatCommandMessage const& message, Player* fromPlayer);
     void QueueChatResponse(const ChatQueuedReply reply);
     void HandleBotOutgoingPacket(WorldPacket const& packet);
     void HandleMasterIncomingPacket(WorldPacket const& packet);
@@ -417,6 +430,7 @@ public:
     void Reset(bool full = false);
     void LeaveOrDisbandGroup();
     static bool IsTank(Player* player, bool bySpec = false);
+    static bool IsFeralTank(Player* player);
     static bool IsHeal(Player* player, bool bySpec = false);
     static bool IsDps(Player* player, bool bySpec = false);
     static bool IsRanged(Player* player, bool bySpec = false);
@@ -426,6 +440,7 @@ public:
     static bool IsCombo(Player* player);
     static bool IsBotMainTank(Player* player);
     static bool IsMainTank(Player* player);
+    static ObjectGuid GetMainTankGuid(Group* group);
     static uint32 GetGroupTankNum(Player* player);
     static bool IsAssistTank(Player* player);
     static bool IsAssistTankOfIndex(Player* player, int index, bool ignoreDeadPlayers = false);
@@ -522,7 +537,9 @@ public:
 
     uint32 GetEquipGearScore(Player* player);
     //uint32 GetEquipGearScore(Player* player, bool withBags, bool withBank);
+    // Cached by sPlayerbotGearScoreCache until the player's items change
     static uint32 GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN = 0);
+    static uint32 CalculateMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN = 0);
     bool HasSkill(SkillType skill);
     bool IsAllowedCommand(std::string const text);
     float GetRange(std::string const type);
@@ -551,6 +568,8 @@ public:
     bool AllowActive(ActivityType activityType);
     bool AllowActivity(ActivityType activityType = ALL_ACTIVITY, bool checkNow = false);
     uint32 AutoScaleActivity(uint32 mod);
+    BotActivityTier GetActivityTier() const { return activityTier; }
+    void SetActivityTier(BotActivityTier tier) { activityTier = tier; }
 
     // Check if player is safe to use.
     bool IsSafe(Player* player);
@@ -614,6 +633,7 @@ private:
     void UpdateAIGroupMaster();
     Item* FindItemInInventory(std::function<bool(ItemTemplate const*)> checkItem) const;
     void HandleCommands();
+    void HandleParsedCommand(uint32 type, ParsedChatCommand const& command, Player* fromPlayer);
     void HandleCommand(uint32 type, const std::string& text, Player& fromPlayer, const uint32 lang = LANG_UNIVERSAL);
     bool _isBotInitializing = false;
     inline bool IsValidUnit(const Unit* unit) const
@@ -646,6 +666,8 @@ protected:
     static std::set<std::string> unsecuredCommands;
     bool allowActive[MAX_ACTIVITY_TYPE];
     time_t allowActiveCheckTimer[MAX_ACTIVITY_TYPE];
+    BotActivityTier activityTier = BOT_ACTIVITY_TIER_FULL;
+    uint32 governorElapsed = 0;
     bool inCombat = false;
     BotCheatMask cheatMask = BotCheatMask::none;
     Position jumpDestination = Position();
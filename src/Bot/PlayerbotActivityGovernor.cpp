@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotActivityGovernor.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "LFGMgr.h"
+#include "Playerbots.h"
+#include "ServerFacade.h"
+#include "UpdateTime.h"
+
+PlayerbotActivityGovernor::PlayerbotActivityGovernor() {}
+
+void PlayerbotActivityGovernor::Init()
+{
+    // dt of the controller is one governor update, gains are tuned per update and not per second.
+    pid.adjust(sPlayerbotAIConfig->activityGovernorKp, sPlayerbotAIConfig->activityGovernorKi,
+               sPlayerbotAIConfig->activityGovernorKd);
+    pid.reset();
+
+    updateTimer = 0;
+    metricsTimer = 0;
+    targetDiff = sPlayerbotAIConfig->activityGovernorTargetDiff;
+    actualDiff = 0;
+    budget = 100.0f;
+    std::fill(std::begin(tierCount), std::end(tierCount), 0);
+    ranked.clear();
+}
+
+bool PlayerbotActivityGovernor::IsEnabled() const
+{
+    return sPlayerbotAIConfig->enabled && sPlayerbotAIConfig->activityGovernorEnabled;
+}
+
+uint32 PlayerbotActivityGovernor::GetTickInterval(BotActivityTier tier) const
+{
+    switch (tier)
+    {
+        case BOT_ACTIVITY_TIER_REDUCED:
+            return sPlayerbotAIConfig->activityGovernorReducedTickInterval;
+        case BOT_ACTIVITY_TIER_DORMANT:
+            return sPlayerbotAIConfig->activityGovernorDormantTickInterval;
+        default:
+            return 0;
+    }
+}
+
+void PlayerbotActivityGovernor::Update(uint32 diff)
+{
+    if (!IsEnabled())
+        return;
+
+    updateTimer += diff;
+    if (updateTimer < sPlayerbotAIConfig->activityGovernorInterval)
+        return;
+
+    updateTimer = 0;
+
+    targetDiff = sPlayerbotAIConfig->activityGovernorTargetDiff;
+    actualDiff = sWorldUpdateTime.GetAverageUpdateTime();
+
+    // Same mapping as the old ScaleBotActivity: PID output is a +-50% offset around half of the bots active.
+    // Positive error (headroom) raises the budget, a world diff over target lowers it.
+    float const budgetMod = pid.calculate(targetDiff, actualDiff);
+    budget = std::max(0.0f, std::min(100.0f, budgetMod + 50.0f));
+
+    AssignTiers();
+
+    if (sPlayerbotAIConfig->activityGovernorMetricsInterval)
+    {
+        metricsTimer += sPlayerbotAIConfig->activityGovernorInterval;
+        if (metricsTimer >= sPlayerbotAIConfig->activityGovernorMetricsInterval * IN_MILLISECONDS)
+        {
+            metricsTimer = 0;
+            LOG_INFO("playerbots", "{}", GetMetricsLine());
+        }
+    }
+}
+
+BotActivityImportance PlayerbotActivityGovernor::GetImportance(Player* bot, PlayerbotAI* botAI)
+{
+    if (bot->IsInCombat())
+        return BOT_IMPORTANCE_PINNED;
+
+    if (botAI->HasRealPlayerMaster())
+        return BOT_IMPORTANCE_PINNED;
+
+    if (botAI->HasPlayerNearby(sPlayerbotAIConfig->BotActiveAloneForceWhenInRadius))
+        return BOT_IMPORTANCE_PINNED;
+
+    if (!WorldPosition(bot).isOverworld())
+        return BOT_IMPORTANCE_GROUPED;
+
+    if (bot->GetGroup() || bot->InBattlegroundQueue())
+        return BOT_IMPORTANCE_GROUPED;
+
+    if (sLFGMgr->GetState(bot->GetGUID()) != lfg::LFG_STATE_NONE)
+        return BOT_IMPORTANCE_GROUPED;
+
+    return BOT_IMPORTANCE_IDLE;
+}
+
+void PlayerbotActivityGovernor::AssignTiers()
+{
+    ranked.clear();
+    std::fill(std::begin(tierCount), std::end(tierCount), 0);
+
+    // Rotates the order inside an importance class once per minute, so the same idle bots are not always dormant.
+    uint32 const cycle = getMSTime() / (60 * IN_MILLISECONDS);
+
+    for (PlayerBotMap::const_iterator it = sRandomPlayerbotMgr->GetPlayerBotsBegin();
+         it != sRandomPlayerbotMgr->GetPlayerBotsEnd(); ++it)
+    {
+        Player* const bot = it->second;
+        if (!bot || !bot->IsInWorld() || bot->IsDuringRemoveFromWorld())
+            continue;
+
+        PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+        if (!botAI || botAI->IsRealPlayer())
+            continue;
+
+        BotActivityImportance const importance = GetImportance(bot, botAI);
+        if (importance == BOT_IMPORTANCE_PINNED)
+        {
+            botAI->SetActivityTier(BOT_ACTIVITY_TIER_FULL);
+            ++tierCount[BOT_ACTIVITY_TIER_FULL];
+            continue;
+        }
+
+        uint32 const rotation = (bot->GetGUID().GetCounter() * 2654435761u + cycle) % 1000;
+        ranked.push_back({botAI, static_cast<uint8>(importance), rotation});
+    }
+
+    std::sort(ranked.begin(), ranked.end(),
+              [](RankedBot const& lhs, RankedBot const& rhs)
+              {
+                  if (lhs.importance != rhs.importance)
+                      return lhs.importance < rhs.importance;
+
+                  return lhs.rotation < rhs.rotation;
+              });
+
+    float const reducedBand = std::min(100.0f, budget + sPlayerbotAIConfig->activityGovernorReducedBand);
+    uint32 const fullSlots = static_cast<uint32>(ranked.size() * budget / 100.0f);
+    uint32 const reducedSlots = static_cast<uint32>(ranked.size() * reducedBand / 100.0f);
+
+    for (uint32 i = 0; i < ranked.size(); ++i)
+    {
+        BotActivityTier tier = BOT_ACTIVITY_TIER_DORMANT;
+        if (i < fullSlots)
+            tier = BOT_ACTIVITY_TIER_FULL;
+        else if (i < reducedSlots)
+            tier = BOT_ACTIVITY_TIER_REDUCED;
+
+        ranked[i].botAI->SetActivityTier(tier);
+        ++tierCount[tier];
+    }
+}
+
+std::string const PlayerbotActivityGovernor::GetMetricsLine() const
+{
+    std::ostringstream out;
+    out << "Activity governor: target diff " << targetDiff << " ms, actual diff " << actualDiff << " ms, budget "
+        << static_cast<uint32>(budget) << "%, full " << tierCount[BOT_ACTIVITY_TIER_FULL] << ", reduced "
+        << tierCount[BOT_ACTIVITY_TIER_REDUCED] << ", dormant " << tierCount[BOT_ACTIVITY_TIER_DORMANT];
+    return out.str();
+}
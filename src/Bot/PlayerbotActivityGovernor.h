@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTACTIVITYGOVERNOR_H
+#define _PLAYERBOT_PLAYERBOTACTIVITYGOVERNOR_H
+
+#include <vector>
+
+#include "Common.h"
+#include "PlayerbotAI.h"
+#include "RandomPlayerbotMgr.h"
+
+class Player;
+
+// Importance classes used to rank random bots, lower is more important.
+enum BotActivityImportance : uint8
+{
+    BOT_IMPORTANCE_PINNED = 0,   // combat, near real players, real player master: always full
+    BOT_IMPORTANCE_GROUPED = 1,  // grouped, instance/bg, bg or lfg queue
+    BOT_IMPORTANCE_IDLE = 2,     // alone in the overworld
+
+    BOT_IMPORTANCE_MAX
+};
+
+// Central closed-loop controller for random bot activity.
+// Holds the world update time around a target by moving a budget of fully active bots up and down with a PID
+// controller, ranks bots by importance and publishes a tier per bot that UpdateAI uses to skip or thin ticks.
+class PlayerbotActivityGovernor
+{
+public:
+    PlayerbotActivityGovernor();
+    static PlayerbotActivityGovernor* instance()
+    {
+        static PlayerbotActivityGovernor instance;
+        return &instance;
+    }
+
+    void Init();
+    void Update(uint32 diff);  // World thread only
+
+    bool IsEnabled() const;
+    // Minimum time between two AI ticks for the given tier, 0 means every tick.
+    uint32 GetTickInterval(BotActivityTier tier) const;
+
+    float GetBudget() const { return budget; }
+    uint32 GetTargetDiff() const { return targetDiff; }
+    uint32 GetActualDiff() const { return actualDiff; }
+    uint32 GetTierCount(BotActivityTier tier) const { return tierCount[tier]; }
+    std::string const GetMetricsLine() const;
+
+private:
+    struct RankedBot
+    {
+        PlayerbotAI* botAI;
+        uint8 importance;
+        uint32 rotation;
+    };
+
+    BotActivityImportance GetImportance(Player* bot, PlayerbotAI* botAI);
+    void AssignTiers();
+
+    botPID pid = botPID(1, 50, -50, 0, 0, 0);
+    uint32 updateTimer = 0;
+    uint32 metricsTimer = 0;
+    uint32 targetDiff = 0;
+    uint32 actualDiff = 0;
+    float budget = 100.0f;
+    uint32 tierCount[BOT_ACTIVITY_TIER_MAX] = {};
+    std::vector<RankedBot> ranked;
+};
+
+#define sPlayerbotActivityGovernor PlayerbotActivityGovernor::instance()
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotBuffCoverage.h"
+
+#include "Chat.h"
+#include "SpellAuras.h"
+#include "SpellInfo.h"
+#include "SpellMgr.h"
+#include "Unit.h"
+#include "Util.h"
+
+extern std::vector<std::string> split(std::string const s, char delim);
+
+uint64 PlayerbotBuffCoverage::GetFamily(std::string const& auras)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(familyLock);
+        std::unordered_map<std::string, uint64>::const_iterator itr = families.find(auras);
+        if (itr != families.end())
+            return itr->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(familyLock);
+    std::unordered_map<std::string, uint64>::const_iterator itr = families.find(auras);
+    if (itr != families.end())
+        return itr->second;
+
+    if (families.size() >= MAX_FAMILIES)
+        return 0;
+
+    uint64 const family = uint64(1) << families.size();
+    families[auras] = family;
+
+    for (std::string const& aura : split(auras, ','))
+    {
+        std::wstring name;
+        if (!Utf8toWStr(aura, name))
+            continue;
+
+        wstrToLower(name);
+        auraFamilies[name] |= family;
+    }
+
+    // Spells resolved so far do not know the new family
+    if (!spellFamilies)
+    {
+        spellCount = sSpellMgr->GetSpellInfoStoreSize();
+        spellFamilies.reset(new std::atomic<uint64>[spellCount]);
+    }
+
+    for (uint32 spellId = 0; spellId < spellCount; ++spellId)
+        spellFamilies[spellId].store(0, std::memory_order_relaxed);
+
+    familyCount.store(families.size(), std::memory_order_release);
+    return family;
+}
+
+uint64 PlayerbotBuffCoverage::GetSpellFamilies(uint32 spellId)
+{
+    if (!familyCount.load(std::memory_order_acquire) || spellId >= spellCount)
+        return 0;
+
+    uint64 const cached = spellFamilies[spellId].load(std::memory_order_relaxed);
+    if (cached & RESOLVED)
+        return cached & ~RESOLVED;
+
+    std::shared_lock<std::shared_mutex> lock(familyLock);
+
+    uint64 bits = 0;
+    SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+    if (spellInfo && spellInfo->SpellName[0])
+    {
+        // Same match as PlayerbotAI::HasAura: whole name, case insensitive
+        std::wstring name;
+        if (Utf8toWStr(spellInfo->SpellName[0], name))
+        {
+            wstrToLower(name);
+            std::unordered_map<std::wstring, uint64>::const_iterator itr = auraFamilies.find(name);
+            if (itr != auraFamilies.end())
+                bits = itr->second;
+        }
+    }
+
+    spellFamilies[spellId].store(bits | RESOLVED, std::memory_order_relaxed);
+    return bits;
+}
+
+uint64 PlayerbotBuffCoverage::ScanFamilies(Unit* unit, uint64 mask, Aura const* ignore)
+{
+    ++scans;
+
+    uint64 covered = 0;
+    for (auto const& itr : unit->GetAppliedAuras())
+    {
+        if (itr.second->GetBase() == ignore)
+            continue;
+
+        covered |= GetSpellFamilies(itr.first);
+    }
+
+    return covered & mask;
+}
+
+bool PlayerbotBuffCoverage::HasFamily(Unit* unit, uint64 family)
+{
+    if (!unit || !family)
+        return false;
+
+    ++queries;
+
+    if (!unit->IsPlayer())
+        return ScanFamilies(unit, family);
+
+    Shard& shard = GetShard(unit->GetGUID());
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    Row& row = shard.rows[unit->GetGUID()];
+    if (row.known & family)
+    {
+        ++rowHits;
+        return row.covered & family;
+    }
+
+    row.covered = (row.covered & ~family) | ScanFamilies(unit, family);
+    row.known |= family;
+    return row.covered & family;
+}
+
+void PlayerbotBuffCoverage::OnAuraApply(Unit* unit, Aura* aura)
+{
+    if (!unit || !aura || !unit->IsPlayer())
+        return;
+
+    uint64 const bits = GetSpellFamilies(aura->GetId());
+    if (!bits)
+        return;
+
+    ++applied;
+
+    Shard& shard = GetShard(unit->GetGUID());
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    std::unordered_map<ObjectGuid, Row>::iterator itr = shard.rows.find(unit->GetGUID());
+    if (itr != shard.rows.end())
+        itr->second.covered |= bits & itr->second.known;
+}
+
+void PlayerbotBuffCoverage::OnAuraRemove(Unit* unit, Aura* aura)
+{
+    if (!unit || !aura || !unit->IsPlayer())
+        return;
+
+    uint64 const bits = GetSpellFamilies(aura->GetId());
+    if (!bits)
+        return;
+
+    ++removed;
+
+    Shard& shard = GetShard(unit->GetGUID());
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    std::unordered_map<ObjectGuid, Row>::iterator itr = shard.rows.find(unit->GetGUID());
+    if (itr == shard.rows.end())
+        return;
+
+    // Another aura of the family (e.g. the single target version of a group buff) may still be there
+    uint64 const tracked = bits & itr->second.known;
+    if (tracked)
+        itr->second.covered = (itr->second.covered & ~tracked) | ScanFamilies(unit, tracked, aura);
+}
+
+void PlayerbotBuffCoverage::OnLogout(ObjectGuid guid)
+{
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.rows.erase(guid);
+}
+
+void PlayerbotBuffCoverage::PrintStats(ChatHandler* handler) const
+{
+    uint32 rows = 0;
+    for (Shard const& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        rows += shard.rows.size();
+    }
+
+    uint64 const total = queries.load();
+    handler->PSendSysMessage("Buff coverage: {} families, {} player rows", familyCount.load(), rows);
+    handler->PSendSysMessage("{} queries, {} answered from rows ({}%), {} aura scans, {} applies, {} removes tracked",
+                             total, rowHits.load(), total ? rowHits.load() * 100 / total : 0, scans.load(),
+                             applied.load(), removed.load());
+}
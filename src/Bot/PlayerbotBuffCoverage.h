@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTBUFFCOVERAGE_H
+#define _PLAYERBOT_PLAYERBOTBUFFCOVERAGE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class Aura;
+class ChatHandler;
+class Unit;
+
+// Which buff families every player has, one bit per family. A family is the comma separated aura list of a
+// "party member without aura" qualifier, e.g. "power word: fortitude,prayer of fortitude". Rows are built from the
+// player's auras on first use and then kept up to date by the aura apply / remove hooks, so a missing buff check
+// is a bit test instead of a name compare against every aura. Pets have no row, their auras are scanned.
+class PlayerbotBuffCoverage
+{
+public:
+    PlayerbotBuffCoverage() {}
+    virtual ~PlayerbotBuffCoverage() {}
+    static PlayerbotBuffCoverage* instance()
+    {
+        static PlayerbotBuffCoverage instance;
+        return &instance;
+    }
+
+    // Bit of the family, 0 when all 64 bits are taken and the caller has to check the auras by name
+    uint64 GetFamily(std::string const& auras);
+    // Whether the unit has an aura of the family. Any thread.
+    bool HasFamily(Unit* unit, uint64 family);
+
+    void OnAuraApply(Unit* unit, Aura* aura);
+    void OnAuraRemove(Unit* unit, Aura* aura);
+    void OnLogout(ObjectGuid guid);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    struct Row
+    {
+        uint64 covered = 0;
+        uint64 known = 0;  // families the row has been calculated for
+    };
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<ObjectGuid, Row> rows;
+    };
+
+    static uint32 const SHARD_COUNT = 16;
+    static uint64 const RESOLVED = uint64(1) << 63;
+    static uint32 const MAX_FAMILIES = 63;
+
+    uint64 GetSpellFamilies(uint32 spellId);
+    uint64 ScanFamilies(Unit* unit, uint64 mask, Aura const* ignore = nullptr);
+    Shard& GetShard(ObjectGuid guid) { return shards[guid.GetCounter() % SHARD_COUNT]; }
+
+    mutable std::shared_mutex familyLock;
+    std::unordered_map<std::string, uint64> families;      // qualifier -> bit
+    std::unordered_map<std::wstring, uint64> auraFamilies;  // lower case aura name -> bits
+    std::unique_ptr<std::atomic<uint64>[]> spellFamilies;  // spell id -> bits | RESOLVED, lazily filled
+    uint32 spellCount = 0;
+    std::atomic<uint32> familyCount{0};  // set after spellFamilies is allocated
+
+    Shard shards[SHARD_COUNT];
+
+    std::atomic<uint64> queries{0};
+    std::atomic<uint64> rowHits{0};
+    std::atomic<uint64> scans{0};
+    std::atomic<uint64> applied{0};
+    std::atomic<uint64> removed{0};
+};
+
+#define sPlayerbotBuffCoverage PlayerbotBuffCoverage::instance()
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotGearScoreCache.h"
+
+#include "Chat.h"
+#include "Player.h"
+#include "PlayerbotAI.h"
+#include "Timer.h"
+
+uint32 PlayerbotGearScoreCache::Get(Player* player, bool withBags, bool withBank, uint32 topN)
+{
+    ++queries;
+
+    ObjectGuid const guid = player->GetGUID();
+    uint32 const variant = (topN << 2) | (withBank ? 2 : 0) | (withBags ? 1 : 0);
+    Shard& shard = GetShard(guid);
+
+    uint32 generation;
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        Row& row = shard.rows[guid];
+        if (!row.scores.empty() && GetMSTimeDiffToNow(row.created) > ROW_LIFETIME)
+        {
+            row.scores.clear();
+            ++row.generation;
+        }
+
+        for (Score const& score : row.scores)
+        {
+            if (score.variant == variant)
+            {
+                ++hits;
+                return score.score;
+            }
+        }
+
+        generation = row.generation;
+    }
+
+    uint32 const score = PlayerbotAI::CalculateMixedGearScore(player, withBags, withBank, topN);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    Row& row = shard.rows[guid];
+    if (row.generation == generation)
+    {
+        if (row.scores.empty())
+            row.created = getMSTime();
+
+        row.scores.push_back({variant, score});
+    }
+
+    return score;
+}
+
+void PlayerbotGearScoreCache::Invalidate(ObjectGuid guid)
+{
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    std::unordered_map<ObjectGuid, Row>::iterator itr = shard.rows.find(guid);
+    if (itr == shard.rows.end())
+        return;
+
+    // Also when empty, a score being calculated right now may predate the change
+    ++itr->second.generation;
+    if (itr->second.scores.empty())
+        return;
+
+    itr->second.scores.clear();
+    ++invalidations;
+}
+
+void PlayerbotGearScoreCache::OnLogout(ObjectGuid guid)
+{
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.rows.erase(guid);
+}
+
+void PlayerbotGearScoreCache::PrintStats(ChatHandler* handler) const
+{
+    uint32 rows = 0;
+    uint32 scores = 0;
+    for (Shard const& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        rows += shard.rows.size();
+        for (auto const& itr : shard.rows)
+            scores += itr.second.scores.size();
+    }
+
+    uint64 const total = queries.load();
+    handler->PSendSysMessage("Gear score cache: {} players, {} cached scores", rows, scores);
+    handler->PSendSysMessage("{} queries, {} hits ({}%), {} invalidations by item changes", total, hits.load(),
+                             total ? hits.load() * 100 / total : 0, invalidations.load());
+}
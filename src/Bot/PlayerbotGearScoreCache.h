@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTGEARSCORECACHE_H
+#define _PLAYERBOT_PLAYERBOTGEARSCORECACHE_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+class Player;
+
+// PlayerbotAI::GetMixedGearScore per player and variant (with bags, with bank, top N). Rows are dropped by the
+// equip, visible slot, store and move out of inventory hooks; destroyed or sold bag items have no hook, so rows
+// also expire after ROW_LIFETIME.
+class PlayerbotGearScoreCache
+{
+public:
+    PlayerbotGearScoreCache() {}
+    virtual ~PlayerbotGearScoreCache() {}
+    static PlayerbotGearScoreCache* instance()
+    {
+        static PlayerbotGearScoreCache instance;
+        return &instance;
+    }
+
+    // Any thread
+    uint32 Get(Player* player, bool withBags, bool withBank, uint32 topN);
+    void Invalidate(ObjectGuid guid);
+    void OnLogout(ObjectGuid guid);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    static uint32 const SHARD_COUNT = 16;
+    static uint32 const ROW_LIFETIME = 30 * IN_MILLISECONDS;
+
+    struct Score
+    {
+        uint32 variant;
+        uint32 score;
+    };
+
+    struct Row
+    {
+        uint32 generation = 0;  // bumped by every invalidation, a score calculated before it is not stored
+        uint32 created = 0;
+        std::vector<Score> scores;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<ObjectGuid, Row> rows;
+    };
+
+    Shard& GetShard(ObjectGuid guid) { return shards[guid.GetCounter() % SHARD_COUNT]; }
+
+    Shard shards[SHARD_COUNT];
+
+    std::atomic<uint64> queries{0};
+    std::atomic<uint64> hits{0};
+    std::atomic<uint64> invalidations{0};
+};
+
+#define sPlayerbotGearScoreCache PlayerbotGearScoreCache::instance()
+
+#endif
@@ -344,6 +344,7 @@ void PlayerbotHolder::LogoutPlayerBot(ObjectGuid guid)
         sPlayerbotWorldProcessor->QueueOperation(std::move(cleanupOp));
 
         LOG_DEBUG("playerbots", "Bot {} logging out", bot->GetName().c_str());
+        sPlayerbotFactoryPlanner->OnLogout(bot);
         bot->SaveToDB(false, false);
 
         WorldSession* botWorldSessionPtr = bot->GetSession();
@@ -1811,6 +1812,22 @@ PlayerbotMgr* PlayerbotsMgr::GetPlayerbotMgr(Player* player)
     return nullptr;
 }
 
+PlayerbotAIBase* PlayerbotsMgr::GetPlayerbotAIBase(Player* player)
+{
+    if (!(sPlayerbotAIConfig->enabled) || !player)
+        return nullptr;
+
+    auto itr = _playerbotsAIMap.find(player->GetGUID());
+    if (itr != _playerbotsAIMap.end())
+        return itr->second;
+
+    itr = _playerbotsMgrMap.find(player->GetGUID());
+    if (itr != _playerbotsMgrMap.end())
+        return itr->second;
+
+    return nullptr;
+}
+
 void PlayerbotMgr::HandleSetSecurityKeyCommand(Player* player, const std::string& key)
 {
     uint32 accountId = player->GetSession()->GetAccountId();
@@ -115,6 +115,8 @@ public:
 
     PlayerbotAI* GetPlayerbotAI(Player* player);
     PlayerbotMgr* GetPlayerbotMgr(Player* player);
+    // PlayerbotAI of a bot, PlayerbotMgr of a real player
+    PlayerbotAIBase* GetPlayerbotAIBase(Player* player);
 
 private:
     std::unordered_map<ObjectGuid, PlayerbotAIBase*> _playerbotsAIMap;
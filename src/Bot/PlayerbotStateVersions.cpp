@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotStateVersions.h"
+
+#include "Chat.h"
+
+PlayerStateVersion PlayerbotStateVersions::Get(ObjectGuid guid) const
+{
+    Shard const& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    std::unordered_map<ObjectGuid, PlayerStateVersion>::const_iterator itr = shard.rows.find(guid);
+    return itr != shard.rows.end() ? itr->second : PlayerStateVersion();
+}
+
+void PlayerbotStateVersions::Bump(ObjectGuid guid, PlayerStateKind kind)
+{
+    uint32 const version = ++serial;
+    ++bumps[kind];
+
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.rows[guid].counters[kind] = version;
+}
+
+void PlayerbotStateVersions::OnLogout(ObjectGuid guid)
+{
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.rows.erase(guid);
+}
+
+void PlayerbotStateVersions::PrintStats(ChatHandler* handler) const
+{
+    uint32 rows = 0;
+    for (Shard const& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        rows += shard.rows.size();
+    }
+
+    handler->PSendSysMessage("State versions: {} players, bumps: {} inventory, {} quests, {} spells, {} level", rows,
+                             bumps[PLAYER_STATE_INVENTORY].load(), bumps[PLAYER_STATE_QUESTS].load(),
+                             bumps[PLAYER_STATE_SPELLS].load(), bumps[PLAYER_STATE_LEVEL].load());
+}
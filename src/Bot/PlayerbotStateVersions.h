@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTSTATEVERSIONS_H
+#define _PLAYERBOT_PLAYERBOTSTATEVERSIONS_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+
+enum PlayerStateKind : uint8
+{
+    PLAYER_STATE_INVENTORY = 0,
+    PLAYER_STATE_QUESTS = 1,
+    PLAYER_STATE_SPELLS = 2,  // spells and skills
+    PLAYER_STATE_LEVEL = 3,
+    PLAYER_STATE_MAX
+};
+
+struct PlayerStateVersion
+{
+    uint32 counters[PLAYER_STATE_MAX] = {};
+
+    bool operator==(PlayerStateVersion const& other) const
+    {
+        for (uint8 kind = 0; kind < PLAYER_STATE_MAX; ++kind)
+            if (counters[kind] != other.counters[kind])
+                return false;
+
+        return true;
+    }
+
+    bool operator!=(PlayerStateVersion const& other) const { return !(*this == other); }
+};
+
+// Per player counters bumped by the player hooks whenever the inventory, the quest log, the known spells and skills
+// or the level change. Values derived from that state remember the version they were calculated at and only
+// calculate again once it moved. Destroyed, sold or used up items and accepted quests have no hook, so such values
+// still need a lifetime of their own.
+class PlayerbotStateVersions
+{
+public:
+    PlayerbotStateVersions() {}
+    virtual ~PlayerbotStateVersions() {}
+    static PlayerbotStateVersions* instance()
+    {
+        static PlayerbotStateVersions instance;
+        return &instance;
+    }
+
+    // Any thread
+    PlayerStateVersion Get(ObjectGuid guid) const;
+    void Bump(ObjectGuid guid, PlayerStateKind kind);
+    void OnLogout(ObjectGuid guid);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    static uint32 const SHARD_COUNT = 16;
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<ObjectGuid, PlayerStateVersion> rows;
+    };
+
+    Shard& GetShard(ObjectGuid guid) { return shards[guid.GetCounter() % SHARD_COUNT]; }
+    Shard const& GetShard(ObjectGuid guid) const { return shards[guid.GetCounter() % SHARD_COUNT]; }
+
+    Shard shards[SHARD_COUNT];
+
+    // Counters are taken from here, so a row dropped at logout and created again never repeats a version
+    std::atomic<uint32> serial{0};
+    std::atomic<uint64> bumps[PLAYER_STATE_MAX]{};
+};
+
+#define sPlayerbotStateVersions PlayerbotStateVersions::instance()
+
+#endif
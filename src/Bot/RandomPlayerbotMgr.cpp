@@ -38,9 +38,11 @@
 #include "PerfMonitor.h"
 #include "Player.h"
 #include "PlayerbotAI.h"
+#include "PlayerbotActivityGovernor.h"
 #include "PlayerbotAIConfig.h"
 #include "PlayerbotCommandServer.h"
 #include "PlayerbotFactory.h"
+#include "PlayerbotRepository.h"
 #include "Playerbots.h"
 #include "Position.h"
 #include "Random.h"
@@ -505,6 +507,9 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
         {
             loginBots += updateBots;
             loginBots = std::min(loginBots, maxNewBots);
+            loginBots = ThrottleLogins(loginBots);
+
+            PreloadBots(availableBots);
 
             LOG_DEBUG("playerbots", "{} new bots prepared to login", loginBots);
 
@@ -1406,6 +1411,92 @@ void RandomPlayerbotMgr::ScheduleChangeStrategy(uint32 bot, uint32 time)
     SetEventValue(bot, "change_strategy", 1, time);
 }
 
+// Loads the events and stored AI state of every offline bot that was not preloaded yet with a few bulk queries,
+// instead of two queries per bot when it logs in.
+void RandomPlayerbotMgr::PreloadBots(std::list<uint32> const& bots)
+{
+    std::vector<uint32> pending;
+    for (uint32 bot : bots)
+    {
+        if (preloadedBots.find(bot) != preloadedBots.end())
+            continue;
+
+        if (GetPlayerBot(bot))
+            continue;
+
+        pending.push_back(bot);
+    }
+
+    if (pending.empty())
+        return;
+
+    uint32 const oldMSTime = getMSTime();
+
+    static uint32 const chunkSize = 1000;
+    for (uint32 offset = 0; offset < pending.size(); offset += chunkSize)
+    {
+        std::ostringstream in;
+        uint32 const last = std::min<uint32>(offset + chunkSize, pending.size());
+        std::unordered_map<uint32, BotEventCache> loaded;
+        for (uint32 i = offset; i < last; ++i)
+        {
+            if (i != offset)
+                in << ",";
+
+            in << pending[i];
+            loaded[pending[i]].loaded = true;
+        }
+
+        if (QueryResult result = PlayerbotsDatabase.Query(
+                "SELECT bot, event, value, time, validIn, data FROM playerbots_random_bots "
+                "WHERE owner = 0 AND bot IN ({})",
+                in.str()))
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+
+                CachedEvent e;
+                e.value = fields[2].Get<uint32>();
+                e.lastChangeTime = fields[3].Get<uint32>();
+                e.validIn = fields[4].Get<uint32>();
+                e.data = fields[5].Get<std::string>();
+
+                loaded[fields[0].Get<uint32>()].events.emplace(fields[1].Get<std::string>(), std::move(e));
+            } while (result->NextRow());
+        }
+
+        // Events already in memory may be newer than the database rows
+        for (auto& itr : loaded)
+        {
+            BotEventCache& cache = eventCache[itr.first];
+            if (!cache.loaded)
+                cache = std::move(itr.second);
+        }
+    }
+
+    sPlayerbotRepository->Preload(pending);
+    preloadedBots.insert(pending.begin(), pending.end());
+
+    LOG_INFO("playerbots", "Preloaded events and AI state of {} bots in {} ms", pending.size(),
+             GetMSTimeDiffToNow(oldMSTime));
+}
+
+// Additive increase / multiplicative decrease of the login rate, driven by the measured world update time.
+uint32 RandomPlayerbotMgr::ThrottleLogins(uint32 loginBots)
+{
+    if (!sPlayerbotAIConfig->randomBotLoginMaxDiff)
+        return loginBots;
+
+    float const maxRate = std::max<uint32>(1, sPlayerbotAIConfig->randomBotsPerInterval);
+    if (sWorldUpdateTime.GetAverageUpdateTime() < sPlayerbotAIConfig->randomBotLoginMaxDiff)
+        loginRate = std::min(maxRate, loginRate + std::max(1.0f, maxRate / 10.0f));
+    else
+        loginRate = std::max(1.0f, loginRate / 2.0f);
+
+    return std::min(loginBots, static_cast<uint32>(loginRate));
+}
+
 bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
 {
     ObjectGuid botGUID = ObjectGuid::Create<HighGuid::Player>(bot);
@@ -2347,7 +2438,7 @@ void RandomPlayerbotMgr::Randomize(Player* bot)
     {
         uint8 level = bot->GetLevel();
         PlayerbotFactory factory(bot, level);
-        factory.Randomize(true);
+        factory.RandomizeAsync(true);
         // IncreaseLevel(bot);
     }
     else
@@ -2372,7 +2463,7 @@ void RandomPlayerbotMgr::IncreaseLevel(Player* bot)
     if (lastLevel != level)
     {
         PlayerbotFactory factory(bot, level);
-        factory.Randomize(true);
+        factory.RandomizeAsync(true);
     }
 
     if (pmo)
@@ -2443,6 +2534,7 @@ void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
 
     SetValue(bot, "level", level);
     PlayerbotFactory factory(bot, level);
+    // Reset and teleported right below, so the bot gets its new gear before that instead of waiting on a plan
     factory.Randomize(false);
 
     uint32 randomTime =
@@ -2484,6 +2576,7 @@ void RandomPlayerbotMgr::RandomizeMin(Player* bot)
     uint32 level = sPlayerbotAIConfig->randomBotMinLevel;
     SetValue(bot, "level", level);
     PlayerbotFactory factory(bot, level);
+    // Reset and teleported right below, so the bot gets its new gear before that instead of waiting on a plan
     factory.Randomize(false);
 
     uint32 randomTime =
@@ -2974,6 +3067,10 @@ bool RandomPlayerbotMgr::HandlePlayerbotConsoleCommand(ChatHandler* handler, cha
 
 void RandomPlayerbotMgr::HandleCommand(uint32 type, std::string const text, Player* fromPlayer, std::string channelName)
 {
+    ChatCommandMessage const message(type, text);
+    if (message.IsEmpty())
+        return;
+
     for (PlayerBotMap::const_iterator it = GetPlayerBotsBegin(); it != GetPlayerBotsEnd(); ++it)
     {
         Player* const bot = it->second;
@@ -2990,10 +3087,81 @@ void RandomPlayerbotMgr::HandleCommand(uint32 type, std::string const text, Play
             }
         }
 
-        GET_PLAYERBOT_AI(bot)->HandleCommand(type, text, fromPlayer);
+        GET_PLAYERBOT_AI(bot)->HandleCommand(message, fromPlayer);
     }
 }
 
+void RandomPlayerbotMgr::HandleChannelCommand(Channel* channel, uint32 type, std::string const& text,
+                                              Player* fromPlayer)
+{
+    if (!channel || !fromPlayer)
+        return;
+
+    // Parsed once and shared by every bot, most channel chatter is dropped here without touching any bot
+    ChatCommandMessage const message(type, text);
+    if (message.IsEmpty())
+        return;
+
+    std::vector<ObjectGuid> candidates = GetChannelBots(channel, fromPlayer->GetTeamId());
+    if (candidates.empty())
+        return;
+
+    // Sample a bounded number of bots, unless the command selects its audience itself (@filters) or comes from a GM
+    uint32 maxBots = sPlayerbotAIConfig->channelCommandMaxBots;
+    if (message.IsTargeted() || fromPlayer->GetSession()->GetSecurity() >= SEC_GAMEMASTER)
+        maxBots = 0;
+
+    uint32 evaluated = 0;
+    for (uint32 i = 0; i < candidates.size(); ++i)
+    {
+        if (maxBots)
+        {
+            if (evaluated >= maxBots)
+                break;
+
+            std::swap(candidates[i], candidates[urand(i, candidates.size() - 1)]);
+        }
+
+        ObjectGuid const guid = candidates[i];
+        if (!channel->IsOn(guid))
+            continue;
+
+        Player* const bot = GetPlayerBot(guid);
+        if (!bot || bot == fromPlayer)
+            continue;
+
+        PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+        if (!botAI)
+            continue;
+
+        botAI->HandleCommand(message, fromPlayer);
+        ++evaluated;
+    }
+}
+
+std::vector<ObjectGuid> RandomPlayerbotMgr::GetChannelBots(Channel* channel, TeamId teamId)
+{
+    std::lock_guard<std::mutex> guard(channelBotIndexLock);
+
+    std::string const key = std::to_string(teamId) + ":" + channel->GetName();
+    ChannelBotIndexEntry& entry = channelBotIndex[key];
+
+    uint32 const now = getMSTime();
+    if (!entry.refreshTime || getMSTimeDiff(entry.refreshTime, now) >= sPlayerbotAIConfig->channelBotIndexRefreshInterval)
+    {
+        entry.bots.clear();
+        for (PlayerBotMap::const_iterator it = GetPlayerBotsBegin(); it != GetPlayerBotsEnd(); ++it)
+        {
+            if (it->second && channel->IsOn(it->first))
+                entry.bots.push_back(it->first);
+        }
+
+        entry.refreshTime = now ? now : 1;
+    }
+
+    return entry.bots;
+}
+
 void RandomPlayerbotMgr::OnPlayerLogout(Player* player)
 {
     DisablePlayerBot(player->GetGUID());
@@ -3340,7 +3508,10 @@ void RandomPlayerbotMgr::PrintStats()
 
     LOG_INFO("playerbots", "Bots status:");
     LOG_INFO("playerbots", "    Active: {}", active);
+    if (sPlayerbotActivityGovernor->IsEnabled())
+        LOG_INFO("playerbots", "    {}", sPlayerbotActivityGovernor->GetMetricsLine());
     LOG_INFO("playerbots", "    Moving: {}", moving);
+    LOG_INFO("playerbots", "    {}", sPlayerbotRepository->GetStatsLine());
 
     // LOG_INFO("playerbots", "Bots to:");
     // LOG_INFO("playerbots", "    update: {}", update);
@@ -6,6 +6,10 @@
 #ifndef _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 #define _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 
+#include <mutex>
+#include <unordered_set>
+
+#include "ChatCommandMessage.h"
 #include "NewRpgInfo.h"
 #include "ObjectGuid.h"
 #include "PlayerbotMgr.h"
@@ -42,6 +46,7 @@ struct BattlegroundInfo
     uint32 bgAlliancePlayerCount = 0;
 };
 
+class Channel;
 class ChatHandler;
 class PerfMonitorOperation;
 class WorldLocation;
@@ -62,6 +67,13 @@ struct BotEventCache
     std::unordered_map<std::string, CachedEvent> events;
 };
 
+// Random bots that are members of a chat channel, refreshed lazily when a message arrives.
+struct ChannelBotIndexEntry
+{
+    std::vector<ObjectGuid> bots;
+    uint32 refreshTime = 0;
+};
+
 // https://gist.github.com/bradley219/5373998
 
 class botPIDImpl;
@@ -113,6 +125,7 @@ public:
     void ScheduleTeleport(uint32 bot, uint32 time = 0);
     void ScheduleChangeStrategy(uint32 bot, uint32 time = 0);
     void HandleCommand(uint32 type, std::string const text, Player* fromPlayer, std::string channelName = "");
+    void HandleChannelCommand(Channel* channel, uint32 type, std::string const& text, Player* fromPlayer);
     std::string const HandleRemoteCommand(std::string const request);
     void OnPlayerLogout(Player* player);
     void OnPlayerLogin(Player* player);
@@ -213,6 +226,8 @@ private:
     time_t DelayLoginBotsTimer;
     time_t printStatsTimer;
     uint32 AddRandomBots();
+    void PreloadBots(std::list<uint32> const& bots);
+    uint32 ThrottleLogins(uint32 loginBots);
     bool ProcessBot(uint32 bot);
     void ScheduleRandomize(uint32 bot, uint32 time);
     void RandomTeleport(Player* bot);
@@ -226,7 +241,12 @@ private:
     std::map<uint32, std::map<uint32, std::vector<WorldLocation>>> rpgLocsCacheLevel;
     std::map<TeamId, std::map<BattlegroundTypeId, std::vector<uint32>>> BattleMastersCache;
     std::unordered_map<uint32, BotEventCache> eventCache;
+    std::unordered_map<std::string, ChannelBotIndexEntry> channelBotIndex;
+    std::mutex channelBotIndexLock;
+    std::vector<ObjectGuid> GetChannelBots(Channel* channel, TeamId teamId);
     std::list<uint32> currentBots;
+    std::unordered_set<uint32> preloadedBots;
+    float loginRate = 1.0f;
     uint32 bgBotsCount;
     uint32 playersLevel;
 
@@ -5,44 +5,169 @@
 
 #include "PlayerbotRepository.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include "Playerbots.h"
+#include "World.h"
+
+// Keeps the IN lists and VALUES lists of a single statement at a sane size
+static uint32 const STATEMENT_CHUNK_SIZE = 500;
+// Widths of playerbots_db_store.key and value; longer strings fail the transaction or are cut by the server
+static uint32 const KEY_COLUMN_WIDTH = 32;
+static uint32 const VALUE_COLUMN_WIDTH = 255;
+
+void PlayerbotStoredState::Add(std::string const& key, std::string const& value)
+{
+    if (key == "value")
+        values.push_back(value);
+    else if (key == "co")
+    {
+        combat = value;
+        hasCombat = true;
+    }
+    else if (key == "nc")
+    {
+        nonCombat = value;
+        hasNonCombat = true;
+    }
+    else if (key == "dead")
+    {
+        dead = value;
+        hasDead = true;
+    }
+}
 
 void PlayerbotRepository::Load(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
+    PlayerbotStoredRows rows;
+    bool known = false;
+
+    // An unsaved or already known state is newer than, or equal to, the database copy
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::unordered_map<uint32, PlayerbotStoredRows>::const_iterator itr = pending.find(guid);
+        if (itr != pending.end())
+        {
+            rows = itr->second;
+            known = true;
+        }
+        else if (flushing.find(guid) != flushing.end())
+        {
+            rows = flushing.find(guid)->second.rows;
+            known = true;
+        }
+        else if ((itr = persisted.find(guid)) != persisted.end())
+        {
+            rows = itr->second;
+            known = true;
+        }
+    }
+
+    if (known)
+    {
+        Apply(botAI, rows);
+        return;
+    }
+
     PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_DB_STORE);
     stmt->SetData(0, guid);
     if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
     {
-        std::vector<std::string> values;
         do
         {
             Field* fields = result->Fetch();
-            std::string const key = fields[0].Get<std::string>();
-            std::string const value = fields[1].Get<std::string>();
+            rows.emplace_back(fields[0].Get<std::string>(), fields[1].Get<std::string>());
+        } while (result->NextRow());
+    }
 
-            if (key == "value")
-                values.push_back(value);
-            else if (key == "co")
-            {
-                botAI->ClearStrategies(BOT_STATE_COMBAT);
-                botAI->ChangeStrategy("+chat", BOT_STATE_COMBAT);
-                botAI->ChangeStrategy(value, BOT_STATE_COMBAT);
-            }
-            else if (key == "nc")
+    Apply(botAI, rows);
+
+    std::sort(rows.begin(), rows.end());
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (persisted.find(guid) == persisted.end() && flushing.find(guid) == flushing.end())
+    {
+        if (lastHash.find(guid) == lastHash.end())
+            lastHash[guid] = Hash(rows);
+
+        persisted[guid] = std::move(rows);
+    }
+}
+
+void PlayerbotRepository::Apply(PlayerbotAI* botAI, PlayerbotStoredRows const& rows)
+{
+    if (rows.empty())
+        return;
+
+    PlayerbotStoredState state;
+    for (auto const& row : rows)
+        state.Add(row.first, row.second);
+
+    if (state.hasCombat)
+    {
+        botAI->ClearStrategies(BOT_STATE_COMBAT);
+        botAI->ChangeStrategy("+chat", BOT_STATE_COMBAT);
+        botAI->ChangeStrategy(state.combat, BOT_STATE_COMBAT);
+    }
+
+    if (state.hasNonCombat)
+    {
+        botAI->ClearStrategies(BOT_STATE_NON_COMBAT);
+        botAI->ChangeStrategy("+chat", BOT_STATE_NON_COMBAT);
+        botAI->ChangeStrategy(state.nonCombat, BOT_STATE_NON_COMBAT);
+    }
+
+    if (state.hasDead)
+        botAI->ChangeStrategy(state.dead, BOT_STATE_DEAD);
+
+    botAI->GetAiObjectContext()->Load(state.values);
+}
+
+void PlayerbotRepository::Preload(std::vector<uint32> const& guids)
+{
+    for (uint32 offset = 0; offset < guids.size(); offset += STATEMENT_CHUNK_SIZE)
+    {
+        std::ostringstream in;
+        uint32 const last = std::min<uint32>(offset + STATEMENT_CHUNK_SIZE, guids.size());
+        for (uint32 i = offset; i < last; ++i)
+        {
+            if (i != offset)
+                in << ",";
+
+            in << guids[i];
+        }
+
+        std::unordered_map<uint32, PlayerbotStoredRows> chunk;
+        for (uint32 i = offset; i < last; ++i)
+            chunk[guids[i]];  // bots without rows are known to be empty, so Load does not query them again
+
+        if (QueryResult result = PlayerbotsDatabase.Query(
+                "SELECT guid, `key`, value FROM playerbots_db_store WHERE guid IN ({})", in.str()))
+        {
+            do
             {
-                botAI->ClearStrategies(BOT_STATE_NON_COMBAT);
-                botAI->ChangeStrategy("+chat", BOT_STATE_NON_COMBAT);
-                botAI->ChangeStrategy(value, BOT_STATE_NON_COMBAT);
-            }
-            else if (key == "dead")
-                botAI->ChangeStrategy(value, BOT_STATE_DEAD);
-        } while (result->NextRow());
+                Field* fields = result->Fetch();
+                chunk[fields[0].Get<uint32>()].emplace_back(fields[1].Get<std::string>(),
+                                                            fields[2].Get<std::string>());
+            } while (result->NextRow());
+        }
 
-        botAI->GetAiObjectContext()->Load(values);
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto& itr : chunk)
+        {
+            if (persisted.find(itr.first) != persisted.end() || flushing.find(itr.first) != flushing.end())
+                continue;
+
+            std::sort(itr.second.begin(), itr.second.end());
+            if (lastHash.find(itr.first) == lastHash.end())
+                lastHash[itr.first] = Hash(itr.second);
+
+            persisted[itr.first] = std::move(itr.second);
+        }
     }
 }
 
@@ -50,22 +175,19 @@ void PlayerbotRepository::Save(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    Reset(botAI);
-
-    PlayerbotsDatabasePreparedStatement* deleteStatement =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_DB_STORE);
-    deleteStatement->SetData(0, guid);
-    PlayerbotsDatabase.Execute(deleteStatement);
+    PlayerbotStoredRows rows;
 
     std::vector<std::string> data = botAI->GetAiObjectContext()->Save();
     for (std::vector<std::string>::iterator i = data.begin(); i != data.end(); ++i)
     {
-        SaveValue(guid, "value", *i);
+        rows.emplace_back("value", *i);
     }
 
-    SaveValue(guid, "co", FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT)));
-    SaveValue(guid, "nc", FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT)));
-    SaveValue(guid, "dead", FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD)));
+    rows.emplace_back("co", FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT)));
+    rows.emplace_back("nc", FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT)));
+    rows.emplace_back("dead", FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD)));
+
+    Queue(guid, std::move(rows));
 }
 
 std::string const PlayerbotRepository::FormatStrategies(std::string const type, std::vector<std::string> strategies)
@@ -82,16 +204,265 @@ void PlayerbotRepository::Reset(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_DB_STORE);
-    stmt->SetData(0, guid);
-    PlayerbotsDatabase.Execute(stmt);
+    Queue(guid, PlayerbotStoredRows());
 }
 
-void PlayerbotRepository::SaveValue(uint32 guid, std::string const key, std::string const value)
+// Cuts the text to at most width bytes without splitting a utf8 character
+static void TruncateToColumn(std::string& text, uint32 width)
 {
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_INS_DB_STORE);
-    stmt->SetData(0, guid);
-    stmt->SetData(1, key);
-    stmt->SetData(2, value);
-    PlayerbotsDatabase.Execute(stmt);
+    if (text.size() <= width)
+        return;
+
+    uint32 end = width;
+    while (end && (static_cast<uint8>(text[end]) & 0xC0) == 0x80)
+        --end;
+
+    text.resize(end);
+}
+
+void PlayerbotRepository::Queue(uint32 guid, PlayerbotStoredRows rows)
+{
+    // What the database will hold, so the diff of the next flush compares like with like
+    for (auto& row : rows)
+    {
+        TruncateToColumn(row.first, KEY_COLUMN_WIDTH);
+        TruncateToColumn(row.second, VALUE_COLUMN_WIDTH);
+    }
+
+    std::sort(rows.begin(), rows.end());
+    uint64 const hash = Hash(rows);
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        std::unordered_map<uint32, uint64>::const_iterator itr = lastHash.find(guid);
+        if (itr != lastHash.end() && itr->second == hash)
+        {
+            ++savesSkipped;
+            rowsSkipped += rows.size();
+            return;
+        }
+
+        lastHash[guid] = hash;
+        pending[guid] = std::move(rows);
+        ++savesQueued;
+    }
+
+    // No more world updates to flush from
+    if (World::IsStopped())
+        Flush();
+}
+
+uint64 PlayerbotRepository::Hash(PlayerbotStoredRows const& rows)
+{
+    uint64 hash = 14695981039346656037ull;
+    for (auto const& row : rows)
+    {
+        hash = (hash ^ std::hash<std::string>()(row.first)) * 1099511628211ull;
+        hash = (hash ^ std::hash<std::string>()(row.second)) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+void PlayerbotRepository::Update(uint32 diff)
+{
+    callbacks.ProcessReadyCallbacks();
+
+    flushTimer += diff;
+    if (flushTimer < sPlayerbotAIConfig->repositoryFlushInterval)
+        return;
+
+    flushTimer = 0;
+    Flush();
+}
+
+void PlayerbotRepository::Flush()
+{
+    std::vector<FlushRows> shared;
+    std::vector<FlushRows> alone;  // failed in a shared transaction before, written in one of their own
+    uint64 unchanged = 0;
+    uint64 batch = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (pending.empty())
+            return;
+
+        batch = ++lastBatch;
+
+        for (auto& itr : pending)
+        {
+            FlushRows flush;
+            flush.guid = itr.first;
+            flush.rows = std::move(itr.second);
+
+            std::unordered_map<uint32, PlayerbotStoredRows>::const_iterator known = persisted.find(flush.guid);
+            if (known == persisted.end())
+            {
+                flush.cleared = true;
+            }
+            else
+            {
+                // Rows are deleted by guid and key, every row of a changed key is written again
+                PlayerbotStoredRows changedRows;
+                std::set_symmetric_difference(known->second.begin(), known->second.end(), flush.rows.begin(),
+                                              flush.rows.end(), std::back_inserter(changedRows));
+
+                for (auto const& row : changedRows)
+                    if (std::find(flush.keys.begin(), flush.keys.end(), row.first) == flush.keys.end())
+                        flush.keys.push_back(row.first);
+
+                for (auto const& row : flush.rows)
+                    if (std::find(flush.keys.begin(), flush.keys.end(), row.first) == flush.keys.end())
+                        ++unchanged;
+            }
+
+            // The database state is only known again once the transaction committed
+            persisted.erase(flush.guid);
+            flushing[flush.guid] = {batch, flush.rows};
+
+            if (isolated.find(flush.guid) != isolated.end())
+                alone.push_back(std::move(flush));
+            else
+                shared.push_back(std::move(flush));
+        }
+
+        pending.clear();
+    }
+
+    rowsSkipped += unchanged;
+
+    if (!shared.empty())
+        Write(shared, batch);
+
+    for (FlushRows& flush : alone)
+        Write(std::vector<FlushRows>(1, std::move(flush)), batch);
+}
+
+void PlayerbotRepository::Write(std::vector<FlushRows> const& flushes, uint64 batch)
+{
+    std::vector<uint32> guids;
+    std::vector<uint32> cleared;  // database state unknown, delete all rows of the bot
+    std::vector<std::pair<uint32, std::string>> deleted;
+    std::vector<std::pair<uint32, std::pair<std::string, std::string>>> inserted;
+
+    for (FlushRows const& flush : flushes)
+    {
+        guids.push_back(flush.guid);
+
+        if (flush.cleared)
+            cleared.push_back(flush.guid);
+
+        for (std::string const& key : flush.keys)
+            deleted.emplace_back(flush.guid, key);
+
+        for (auto const& row : flush.rows)
+            if (flush.cleared || std::find(flush.keys.begin(), flush.keys.end(), row.first) != flush.keys.end())
+                inserted.emplace_back(flush.guid, row);
+    }
+
+    if (cleared.empty() && deleted.empty() && inserted.empty())
+    {
+        OnWritten(guids, batch, true, 0, 0);
+        return;
+    }
+
+    auto quote = [](std::string value)
+    {
+        PlayerbotsDatabase.EscapeString(value);
+        return "'" + value + "'";
+    };
+
+    PlayerbotsDatabaseTransaction trans = PlayerbotsDatabase.BeginTransaction();
+
+    for (uint32 offset = 0; offset < cleared.size(); offset += STATEMENT_CHUNK_SIZE)
+    {
+        std::ostringstream out;
+        out << "DELETE FROM playerbots_db_store WHERE guid IN (";
+        for (uint32 i = offset; i < std::min<uint32>(offset + STATEMENT_CHUNK_SIZE, cleared.size()); ++i)
+            out << (i != offset ? "," : "") << cleared[i];
+        out << ")";
+        trans->Append(out.str());
+    }
+
+    for (uint32 offset = 0; offset < deleted.size(); offset += STATEMENT_CHUNK_SIZE)
+    {
+        std::ostringstream out;
+        out << "DELETE FROM playerbots_db_store WHERE (guid, `key`) IN (";
+        for (uint32 i = offset; i < std::min<uint32>(offset + STATEMENT_CHUNK_SIZE, deleted.size()); ++i)
+            out << (i != offset ? "," : "") << "(" << deleted[i].first << "," << quote(deleted[i].second) << ")";
+        out << ")";
+        trans->Append(out.str());
+    }
+
+    for (uint32 offset = 0; offset < inserted.size(); offset += STATEMENT_CHUNK_SIZE)
+    {
+        std::ostringstream out;
+        out << "INSERT INTO playerbots_db_store (guid, `key`, value) VALUES ";
+        for (uint32 i = offset; i < std::min<uint32>(offset + STATEMENT_CHUNK_SIZE, inserted.size()); ++i)
+            out << (i != offset ? "," : "") << "(" << inserted[i].first << "," << quote(inserted[i].second.first) << ","
+                << quote(inserted[i].second.second) << ")";
+        trans->Append(out.str());
+    }
+
+    uint64 const deletedCount = deleted.size();
+    uint64 const insertedCount = inserted.size();
+    callbacks.AddCallback(PlayerbotsDatabase.AsyncCommitTransaction(trans).AfterComplete(
+        [this, guids, batch, deletedCount, insertedCount](bool success)
+        { OnWritten(guids, batch, success, deletedCount, insertedCount); }));
+}
+
+void PlayerbotRepository::OnWritten(std::vector<uint32> const& guids, uint64 batch, bool success, uint64 deletedCount,
+                                    uint64 insertedCount)
+{
+    if (success)
+    {
+        rowsDeleted += deletedCount;
+        rowsInserted += insertedCount;
+        ++batches;
+    }
+    else
+    {
+        ++failedBatches;
+        LOG_ERROR("playerbots",
+                  "Repository: writing the state of {} bots failed, the next flush writes them again alone",
+                  guids.size());
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (uint32 guid : guids)
+    {
+        std::unordered_map<uint32, FlushingRows>::iterator itr = flushing.find(guid);
+        if (itr == flushing.end() || itr->second.batch != batch)
+            continue;  // a later flush owns the bot now
+
+        if (success)
+        {
+            persisted[guid] = std::move(itr->second.rows);
+            if (guids.size() == 1)
+                isolated.erase(guid);
+        }
+        else
+        {
+            // Queued again unless a newer save replaced them; the database rows are unknown now, so the retry
+            // deletes everything of the bot first
+            if (pending.find(guid) == pending.end())
+                pending[guid] = std::move(itr->second.rows);
+
+            isolated.insert(guid);
+        }
+
+        flushing.erase(itr);
+    }
+}
+
+std::string const PlayerbotRepository::GetStatsLine() const
+{
+    std::ostringstream out;
+    out << "Repository: " << savesQueued.load() << " saves queued, " << savesSkipped.load()
+        << " unchanged saves skipped, " << rowsInserted.load() << " rows inserted, " << rowsDeleted.load()
+        << " rows deleted, " << rowsSkipped.load() << " unchanged rows skipped, " << batches.load() << " batches, "
+        << failedBatches.load() << " failed";
+    return out.str();
 }
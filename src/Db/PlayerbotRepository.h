@@ -6,12 +6,41 @@
 #ifndef _PLAYERBOT_PLAYERBOTREPOSITORY_H
 #define _PLAYERBOT_PLAYERBOTREPOSITORY_H
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "AsyncCallbackProcessor.h"
 #include "Common.h"
+#include "DatabaseEnvFwd.h"
+#include "Transaction.h"
 
 class PlayerbotAI;
 
+//                               key,         value
+typedef std::vector<std::pair<std::string, std::string>> PlayerbotStoredRows;
+
+// Contents of playerbots_db_store for one bot, already split by key.
+struct PlayerbotStoredState
+{
+    std::vector<std::string> values;
+    std::string combat;
+    std::string nonCombat;
+    std::string dead;
+    bool hasCombat = false;
+    bool hasNonCombat = false;
+    bool hasDead = false;
+
+    void Add(std::string const& key, std::string const& value);
+};
+
+// Saves are queued and written by Update in batches: rows of every bot saved since the last flush are diffed
+// against what is known to be in playerbots_db_store and only keys with changed rows are deleted / inserted, with
+// multi-row statements in one asynchronous transaction. Rows count as written once the transaction committed; bots
+// of a failed transaction are queued again and the next flush writes each in a transaction of its own.
 class PlayerbotRepository
 {
 public:
@@ -27,9 +56,55 @@ public:
     void Load(PlayerbotAI* botAI);
     void Reset(PlayerbotAI* botAI);
 
+    // Fetches the stored state of many bots with one query per chunk, Load then uses it instead of querying.
+    void Preload(std::vector<uint32> const& guids);
+
+    void Update(uint32 diff);  // World thread only
+    void Flush();
+
+    std::string const GetStatsLine() const;
+
 private:
-    void SaveValue(uint32 guid, std::string const key, std::string const value);
+    // Rows of one bot in a flush: all rows, and the keys whose rows are deleted and written again
+    struct FlushRows
+    {
+        uint32 guid = 0;
+        bool cleared = false;  // database state unknown, all rows of the bot are deleted and written
+        std::vector<std::string> keys;
+        PlayerbotStoredRows rows;
+    };
+
+    struct FlushingRows
+    {
+        uint64 batch;
+        PlayerbotStoredRows rows;
+    };
+
+    void Queue(uint32 guid, PlayerbotStoredRows rows);
+    void Write(std::vector<FlushRows> const& flushes, uint64 batch);
+    void OnWritten(std::vector<uint32> const& guids, uint64 batch, bool success, uint64 deletedCount,
+                   uint64 insertedCount);
+    void Apply(PlayerbotAI* botAI, PlayerbotStoredRows const& rows);
+    static uint64 Hash(PlayerbotStoredRows const& rows);
     std::string const FormatStrategies(std::string const type, std::vector<std::string> strategies);
+
+    std::mutex lock;
+    std::unordered_map<uint32, PlayerbotStoredRows> pending;    // latest unsaved state per bot, sorted
+    std::unordered_map<uint32, PlayerbotStoredRows> persisted;  // rows known to be in the database, sorted
+    std::unordered_map<uint32, uint64> lastHash;                // hash of the pending or persisted state
+    std::unordered_map<uint32, FlushingRows> flushing;          // written by a transaction not committed yet
+    std::unordered_set<uint32> isolated;                        // failed in a shared transaction
+    uint64 lastBatch = 0;
+    uint32 flushTimer = 0;
+    AsyncCallbackProcessor<TransactionCallback> callbacks;
+
+    std::atomic<uint64> savesQueued{0};
+    std::atomic<uint64> savesSkipped{0};
+    std::atomic<uint64> rowsInserted{0};
+    std::atomic<uint64> rowsDeleted{0};
+    std::atomic<uint64> rowsSkipped{0};
+    std::atomic<uint64> batches{0};
+    std::atomic<uint64> failedBatches{0};
 };
 
 #define sPlayerbotRepository PlayerbotRepository::instance()
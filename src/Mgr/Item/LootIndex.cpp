@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "LootIndex.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Chat.h"
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "Timer.h"
+
+namespace
+{
+struct LootLink
+{
+    uint32 itemId;
+    int32 entry;
+    float chance;
+};
+
+template <class Key>
+uint32 FindKey(std::vector<Key> const& keys, Key key)
+{
+    typename std::vector<Key>::const_iterator itr = std::lower_bound(keys.begin(), keys.end(), key);
+    if (itr == keys.end() || *itr != key)
+        return keys.size();
+
+    return std::distance(keys.begin(), itr);
+}
+}  // namespace
+
+LootTemplateAccess const* LootIndex::GetLootTemplate(ObjectGuid guid, LootType type)
+{
+    LootTemplate const* lTemplate = nullptr;
+
+    if (guid.IsCreature())
+    {
+        CreatureTemplate const* info = sObjectMgr->GetCreatureTemplate(guid.GetEntry());
+
+        if (info)
+        {
+            if (type == LOOT_CORPSE)
+                lTemplate = LootTemplates_Creature.GetLootFor(info->lootid);
+            else if (type == LOOT_PICKPOCKETING && info->pickpocketLootId)
+                lTemplate = LootTemplates_Pickpocketing.GetLootFor(info->pickpocketLootId);
+            else if (type == LOOT_SKINNING && info->SkinLootId)
+                lTemplate = LootTemplates_Skinning.GetLootFor(info->SkinLootId);
+        }
+    }
+    else if (guid.IsGameObject())
+    {
+        GameObjectTemplate const* info = sObjectMgr->GetGameObjectTemplate(guid.GetEntry());
+        if (info && info->GetLootId() != 0)
+        {
+            if (type == LOOT_CORPSE)
+                lTemplate = LootTemplates_Gameobject.GetLootFor(info->GetLootId());
+            else if (type == LOOT_FISHINGHOLE)
+                lTemplate = LootTemplates_Fishing.GetLootFor(info->GetLootId());
+        }
+    }
+    else if (guid.IsItem())
+    {
+        ItemTemplate const* proto = sObjectMgr->GetItemTemplate(guid.GetEntry());
+
+        if (proto)
+        {
+            if (type == LOOT_CORPSE)
+                lTemplate = LootTemplates_Item.GetLootFor(proto->ItemId);
+            else if (type == LOOT_DISENCHANTING && proto->DisenchantID)
+                lTemplate = LootTemplates_Disenchant.GetLootFor(proto->DisenchantID);
+            if (type == LOOT_MILLING)
+                lTemplate = LootTemplates_Milling.GetLootFor(proto->ItemId);
+            if (type == LOOT_PROSPECTING)
+                lTemplate = LootTemplates_Prospecting.GetLootFor(proto->ItemId);
+        }
+    }
+
+    LootTemplateAccess const* lTemplateA = reinterpret_cast<LootTemplateAccess const*>(lTemplate);
+
+    return lTemplateA;
+}
+
+void LootIndex::Build()
+{
+    uint32 const oldMSTime = getMSTime();
+
+    std::vector<LootLink> links;
+
+    if (CreatureTemplateContainer const* creatures = sObjectMgr->GetCreatureTemplates())
+    {
+        for (auto const& itr : *creatures)
+        {
+            int32 const entry = itr.first;
+
+            if (LootTemplateAccess const* lTemplateA =
+                    GetLootTemplate(ObjectGuid::Create<HighGuid::Unit>(entry, uint32(1)), LOOT_CORPSE))
+                for (auto const& lItem : lTemplateA->Entries)
+                    if (!lItem->reference)
+                        links.push_back({lItem->itemid, entry, lItem->chance});
+        }
+    }
+
+    if (GameObjectTemplateContainer const* gameobjects = sObjectMgr->GetGameObjectTemplates())
+    {
+        for (auto const& itr : *gameobjects)
+        {
+            int32 const entry = itr.first;
+
+            if (LootTemplateAccess const* lTemplateA =
+                    GetLootTemplate(ObjectGuid::Create<HighGuid::GameObject>(entry, uint32(1)), LOOT_CORPSE))
+                for (auto const& lItem : lTemplateA->Entries)
+                    if (!lItem->reference)
+                        links.push_back({lItem->itemid, -entry, lItem->chance});
+        }
+    }
+
+    itemKeys.clear();
+    itemOffsets.clear();
+    itemSources.clear();
+    sourceKeys.clear();
+    sourceOffsets.clear();
+    sourceItems.clear();
+
+    // item -> sources
+    std::sort(links.begin(), links.end(),
+              [](LootLink const& lhs, LootLink const& rhs)
+              {
+                  if (lhs.itemId != rhs.itemId)
+                      return lhs.itemId < rhs.itemId;
+
+                  return lhs.entry < rhs.entry;
+              });
+
+    itemSources.reserve(links.size());
+    for (LootLink const& link : links)
+    {
+        if (itemKeys.empty() || itemKeys.back() != link.itemId)
+        {
+            itemKeys.push_back(link.itemId);
+            itemOffsets.push_back(itemSources.size());
+        }
+
+        itemSources.push_back({link.entry, link.chance});
+    }
+    itemOffsets.push_back(itemSources.size());
+
+    // source -> items
+    std::sort(links.begin(), links.end(),
+              [](LootLink const& lhs, LootLink const& rhs)
+              {
+                  if (lhs.entry != rhs.entry)
+                      return lhs.entry < rhs.entry;
+
+                  return lhs.itemId < rhs.itemId;
+              });
+
+    sourceItems.reserve(links.size());
+    for (LootLink const& link : links)
+    {
+        if (sourceKeys.empty() || sourceKeys.back() != link.entry)
+        {
+            sourceKeys.push_back(link.entry);
+            sourceOffsets.push_back(sourceItems.size());
+        }
+
+        sourceItems.push_back({link.itemId, link.chance});
+    }
+    sourceOffsets.push_back(sourceItems.size());
+
+    itemKeys.shrink_to_fit();
+    itemOffsets.shrink_to_fit();
+    sourceKeys.shrink_to_fit();
+    sourceOffsets.shrink_to_fit();
+
+    buildTime = GetMSTimeDiffToNow(oldMSTime);
+    built = true;
+
+    LOG_INFO("playerbots", ">> Loot index built: {} items, {} sources, {} links in {} ms", GetItemCount(),
+             GetSourceCount(), GetLinkCount(), buildTime);
+}
+
+LootIndexRange<LootIndexSource> LootIndex::GetItemSources(uint32 itemId) const
+{
+    uint32 const index = FindKey(itemKeys, itemId);
+    if (index == itemKeys.size())
+        return LootIndexRange<LootIndexSource>();
+
+    return LootIndexRange<LootIndexSource>(itemSources.data() + itemOffsets[index],
+                                           itemSources.data() + itemOffsets[index + 1]);
+}
+
+LootIndexRange<LootIndexItem> LootIndex::GetSourceItems(int32 entry) const
+{
+    uint32 const index = FindKey(sourceKeys, entry);
+    if (index == sourceKeys.size())
+        return LootIndexRange<LootIndexItem>();
+
+    return LootIndexRange<LootIndexItem>(sourceItems.data() + sourceOffsets[index],
+                                         sourceItems.data() + sourceOffsets[index + 1]);
+}
+
+uint64 LootIndex::GetMemoryUsage() const
+{
+    return itemKeys.capacity() * sizeof(uint32) + itemOffsets.capacity() * sizeof(uint32) +
+           itemSources.capacity() * sizeof(LootIndexSource) + sourceKeys.capacity() * sizeof(int32) +
+           sourceOffsets.capacity() * sizeof(uint32) + sourceItems.capacity() * sizeof(LootIndexItem);
+}
+
+void LootIndex::PrintStats(ChatHandler* handler) const
+{
+    std::vector<std::string> lines;
+
+    if (!built)
+    {
+        lines.push_back("Loot index is not built");
+    }
+    else
+    {
+        // Rebuild the map layout the old "drop map" value used, to compare memory and lookup time on live data.
+        uint32 const mapBuildStart = getMSTime();
+        std::unordered_multimap<uint32, int32> dropMap;
+        dropMap.reserve(itemSources.size());
+        for (uint32 i = 0; i < itemKeys.size(); ++i)
+            for (uint32 j = itemOffsets[i]; j < itemOffsets[i + 1]; ++j)
+                dropMap.emplace(itemKeys[i], itemSources[j].entry);
+        uint32 const mapBuildTime = GetMSTimeDiffToNow(mapBuildStart);
+
+        // node: next pointer + key/value + cached hash, plus one bucket pointer per bucket
+        uint64 const nodeSize = sizeof(void*) + sizeof(std::pair<uint32 const, int32>) + sizeof(size_t);
+        uint64 const mapMemory = dropMap.size() * nodeSize + dropMap.bucket_count() * sizeof(void*);
+
+        uint32 const rounds = 10;
+        uint64 indexHits = 0;
+        uint64 mapHits = 0;
+
+        uint32 const indexStart = getMSTime();
+        for (uint32 round = 0; round < rounds; ++round)
+            for (uint32 itemId : itemKeys)
+                indexHits += GetItemSources(itemId).size();
+        uint32 const indexTime = GetMSTimeDiffToNow(indexStart);
+
+        uint32 const mapStart = getMSTime();
+        for (uint32 round = 0; round < rounds; ++round)
+            for (uint32 itemId : itemKeys)
+            {
+                // old ItemDropListValue copied the matches into a new vector on every query
+                std::vector<int32> entries;
+                auto range = dropMap.equal_range(itemId);
+                for (auto itr = range.first; itr != range.second; ++itr)
+                    entries.push_back(itr->second);
+                mapHits += entries.size();
+            }
+        uint32 const mapTime = GetMSTimeDiffToNow(mapStart);
+
+        uint32 const lookups = itemKeys.size() * rounds;
+
+        lines.push_back(fmt::format("Loot index: {} items, {} sources, {} links, built in {} ms", GetItemCount(),
+                                    GetSourceCount(), GetLinkCount(), buildTime));
+        lines.push_back(fmt::format("Memory: index {} KB (both directions), hash map {} KB (item -> source only)",
+                                    GetMemoryUsage() / 1024, mapMemory / 1024));
+        lines.push_back(fmt::format("Lookup x{}: index {} ms ({} hits), hash map + vector copy {} ms ({} hits), map "
+                                    "built in {} ms",
+                                    lookups, indexTime, indexHits, mapTime, mapHits, mapBuildTime));
+    }
+
+    for (std::string const& line : lines)
+    {
+        if (handler)
+            handler->PSendSysMessage("{}", line);
+        else
+            LOG_INFO("playerbots", "{}", line);
+    }
+}
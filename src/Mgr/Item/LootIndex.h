@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_LOOTINDEX_H
+#define _PLAYERBOT_LOOTINDEX_H
+
+#include <vector>
+
+#include "Common.h"
+#include "LootMgr.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+
+// Cheat class copy to hack into the loot system
+class LootTemplateAccess
+{
+public:
+    class LootGroup;  // A set of loot definitions for items (refs are not allowed inside)
+    typedef std::vector<LootGroup> LootGroups;
+    LootStoreItemList Entries;  // not grouped only
+    LootGroups Groups;          // groups have own (optimized) processing, grouped entries go there
+};
+
+// entry > 0 is a creature, entry < 0 is a gameobject
+struct LootIndexSource
+{
+    int32 entry;
+    float chance;
+};
+
+struct LootIndexItem
+{
+    uint32 itemId;
+    float chance;
+};
+
+template <class T>
+class LootIndexRange
+{
+public:
+    LootIndexRange() : first(nullptr), last(nullptr) {}
+    LootIndexRange(T const* first, T const* last) : first(first), last(last) {}
+
+    T const* begin() const { return first; }
+    T const* end() const { return last; }
+    uint32 size() const { return static_cast<uint32>(last - first); }
+    bool empty() const { return first == last; }
+
+private:
+    T const* first;
+    T const* last;
+};
+
+// Immutable item <-> loot source index built once at startup from the creature and gameobject loot templates.
+// Both directions are stored CSR style: a sorted key array, an offset array and one contiguous payload array,
+// so a lookup is a binary search and returns a view into shared memory without allocating.
+class LootIndex
+{
+public:
+    static LootIndex* instance()
+    {
+        static LootIndex instance;
+        return &instance;
+    }
+
+    void Build();
+    bool IsBuilt() const { return built; }
+
+    // Creatures (entry > 0) and gameobjects (entry < 0) that can drop the item
+    LootIndexRange<LootIndexSource> GetItemSources(uint32 itemId) const;
+    // Items a creature (entry > 0) or gameobject (entry < 0) can drop
+    LootIndexRange<LootIndexItem> GetSourceItems(int32 entry) const;
+
+    static LootTemplateAccess const* GetLootTemplate(ObjectGuid guid, LootType type = LOOT_CORPSE);
+
+    uint32 GetItemCount() const { return itemKeys.size(); }
+    uint32 GetSourceCount() const { return sourceKeys.size(); }
+    uint32 GetLinkCount() const { return itemSources.size(); }
+    uint64 GetMemoryUsage() const;
+    void PrintStats(ChatHandler* handler = nullptr) const;
+
+private:
+    LootIndex() {}
+
+    bool built = false;
+    uint32 buildTime = 0;
+
+    std::vector<uint32> itemKeys;
+    std::vector<uint32> itemOffsets;
+    std::vector<LootIndexSource> itemSources;
+
+    std::vector<int32> sourceKeys;
+    std::vector<uint32> sourceOffsets;
+    std::vector<LootIndexItem> sourceItems;
+};
+
+#define sLootIndex LootIndex::instance()
+
+#endif
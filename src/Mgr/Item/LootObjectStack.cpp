@@ -5,6 +5,9 @@
 
 #include "LootObjectStack.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "LootMgr.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
@@ -13,36 +16,9 @@
 
 #define MAX_LOOT_OBJECT_COUNT 200
 
-LootTarget::LootTarget(ObjectGuid guid) : guid(guid), asOfTime(time(nullptr)) {}
-
-LootTarget::LootTarget(LootTarget const& other)
-{
-    guid = other.guid;
-    asOfTime = other.asOfTime;
-}
-
-LootTarget& LootTarget::operator=(LootTarget const& other)
-{
-    if ((void*)this == (void*)&other)
-        return *this;
-
-    guid = other.guid;
-    asOfTime = other.asOfTime;
-
-    return *this;
-}
-
-bool LootTarget::operator<(LootTarget const& other) const { return guid < other.guid; }
-
-void LootTargetList::shrink(time_t fromTime)
+LootTarget::LootTarget(ObjectGuid guid)
+    : guid(guid), asOfTime(time(nullptr)), located(false), x(0.0f), y(0.0f), z(0.0f), lootState(0)
 {
-    for (std::set<LootTarget>::iterator i = begin(); i != end();)
-    {
-        if (i->asOfTime <= fromTime)
-            erase(i++);
-        else
-            ++i;
-    }
 }
 
 LootObject::LootObject(Player* bot, ObjectGuid guid) : guid(), skillId(SKILL_NONE), reqSkillValue(0), reqItem(0)
@@ -281,6 +257,14 @@ bool LootObject::IsLootPossible(Player* bot)
     if (!worldObj)
         return false;
 
+    return IsLootPossible(bot, worldObj);
+}
+
+bool LootObject::IsLootPossible(Player* bot, WorldObject* worldObj)
+{
+    if (IsEmpty() || !bot)
+        return false;
+
     PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
     if (!botAI)
     {
@@ -340,30 +324,36 @@ bool LootObject::IsLootPossible(Player* bot)
 
 bool LootObjectStack::Add(ObjectGuid guid)
 {
-    if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
-    {
-        availableLoot.shrink(time(nullptr) - 30);
-    }
+    if (targets.size() >= MAX_LOOT_OBJECT_COUNT)
+        Shrink(time(nullptr) - 30);
 
-    if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
-    {
-        availableLoot.clear();
-    }
+    if (targets.size() >= MAX_LOOT_OBJECT_COUNT)
+        Clear();
 
-    if (!availableLoot.insert(guid).second)
+    std::pair<std::unordered_map<ObjectGuid, LootTarget>::iterator, bool> const added =
+        targets.emplace(guid, LootTarget(guid));
+    if (!added.second)
         return false;
 
+    expiry.emplace_back(added.first->second.asOfTime, guid);
+    unlocated.push_back(guid);
     return true;
 }
 
 void LootObjectStack::Remove(ObjectGuid guid)
 {
-    LootTargetList::iterator i = availableLoot.find(guid);
-    if (i != availableLoot.end())
-        availableLoot.erase(i);
+    std::unordered_map<ObjectGuid, LootTarget>::iterator itr = targets.find(guid);
+    if (itr != targets.end())
+        Erase(itr);
 }
 
-void LootObjectStack::Clear() { availableLoot.clear(); }
+void LootObjectStack::Clear()
+{
+    targets.clear();
+    expiry.clear();
+    unlocated.clear();
+    cells.clear();
+}
 
 bool LootObjectStack::CanLoot(float maxDistance)
 {
@@ -377,34 +367,162 @@ LootObject LootObjectStack::GetLoot(float maxDistance)
     return nearest.IsEmpty() ? LootObject() : nearest;
 }
 
+void LootObjectStack::Erase(std::unordered_map<ObjectGuid, LootTarget>::iterator itr)
+{
+    LootTarget const& target = itr->second;
+    if (target.located)
+    {
+        uint64 const key = GetCellKey(GetCellCoord(target.x), GetCellCoord(target.y));
+        std::unordered_map<uint64, std::vector<ObjectGuid>>::iterator cell = cells.find(key);
+        if (cell != cells.end())
+        {
+            std::vector<ObjectGuid>& guids = cell->second;
+            guids.erase(std::remove(guids.begin(), guids.end(), target.guid), guids.end());
+            if (guids.empty())
+                cells.erase(cell);
+        }
+    }
+    else
+        unlocated.erase(std::remove(unlocated.begin(), unlocated.end(), target.guid), unlocated.end());
+
+    targets.erase(itr);
+}
+
+void LootObjectStack::Shrink(time_t fromTime)
+{
+    while (!expiry.empty() && expiry.front().first <= fromTime)
+    {
+        // Targets removed and added again since have a newer entry further back
+        std::unordered_map<ObjectGuid, LootTarget>::iterator itr = targets.find(expiry.front().second);
+        if (itr != targets.end() && itr->second.asOfTime <= fromTime)
+            Erase(itr);
+
+        expiry.pop_front();
+    }
+}
+
+// Units are added when they are attacked and only get a fixed position once they died
+void LootObjectStack::Locate()
+{
+    for (uint32 i = 0; i < unlocated.size();)
+    {
+        WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, unlocated[i]);
+        Unit* unit = worldObj ? worldObj->ToUnit() : nullptr;
+        if (!worldObj || (unit && unit->IsAlive()))
+        {
+            ++i;
+            continue;
+        }
+
+        LootTarget& target = targets.at(unlocated[i]);
+        target.located = true;
+        target.x = worldObj->GetPositionX();
+        target.y = worldObj->GetPositionY();
+        target.z = worldObj->GetPositionZ();
+        cells[GetCellKey(GetCellCoord(target.x), GetCellCoord(target.y))].push_back(target.guid);
+
+        unlocated[i] = unlocated.back();
+        unlocated.pop_back();
+    }
+}
+
+// Changes whenever the outcome of LootObject::Refresh could change, 0 when there is nothing to loot
+uint32 LootObjectStack::GetLootState(WorldObject* worldObj)
+{
+    if (Creature* creature = worldObj->ToCreature())
+    {
+        if (creature->getDeathState() != DeathState::Corpse)
+            return 0;
+
+        return 1 | (creature->HasFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE) ? 2 : 0) |
+               (creature->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_SKINNABLE) ? 4 : 0);
+    }
+
+    if (GameObject* go = worldObj->ToGameObject())
+    {
+        if (!go->isSpawned())
+            return 0;
+
+        return 8 | (uint32(go->GetGoState()) << 4) | (uint32(go->getLootState()) << 8);
+    }
+
+    return 0;
+}
+
 LootObject LootObjectStack::GetNearest(float maxDistance)
 {
-    availableLoot.shrink(time(nullptr) - 30);
+    Shrink(time(nullptr) - 30);
+    Locate();
+
+    float const botX = bot->GetPositionX();
+    float const botY = bot->GetPositionY();
+    float const botZ = bot->GetPositionZ();
+
+    // Cells by their distance to the bot, nothing in a cell is nearer than the cell itself
+    std::vector<std::pair<float, uint64>> nearCells;
+    nearCells.reserve(cells.size());
+    for (auto const& itr : cells)
+    {
+        float const minX = float(int32(itr.first >> 32)) * CELL_SIZE;
+        float const minY = float(int32(itr.first & 0xFFFFFFFF)) * CELL_SIZE;
+        float const dx = std::max({minX - botX, 0.0f, botX - minX - CELL_SIZE});
+        float const dy = std::max({minY - botY, 0.0f, botY - minY - CELL_SIZE});
+        nearCells.emplace_back(std::sqrt(dx * dx + dy * dy), itr.first);
+    }
+
+    std::sort(nearCells.begin(), nearCells.end());
 
     LootObject nearest;
     float nearestDistance = std::numeric_limits<float>::max();
 
-    LootTargetList safeCopy(availableLoot);
-    for (LootTargetList::iterator i = safeCopy.begin(); i != safeCopy.end(); i++)
+    std::vector<std::pair<float, ObjectGuid>> candidates;
+    for (std::pair<float, uint64> const& cell : nearCells)
     {
-        ObjectGuid guid = i->guid;
+        if (cell.first >= nearestDistance || (maxDistance && cell.first > maxDistance))
+            break;
 
-        WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, guid);
-        if (!worldObj)
-            continue;
+        candidates.clear();
+        for (ObjectGuid const& guid : cells[cell.second])
+        {
+            LootTarget const& target = targets.at(guid);
+            float const dx = target.x - botX;
+            float const dy = target.y - botY;
+            float const dz = target.z - botZ;
+            candidates.emplace_back(std::sqrt(dx * dx + dy * dy + dz * dz), guid);
+        }
 
-        float distance = bot->GetDistance(worldObj);
+        std::sort(candidates.begin(), candidates.end());
+        for (std::pair<float, ObjectGuid> const& candidate : candidates)
+        {
+            if (candidate.first >= nearestDistance)
+                break;
 
-        if (distance >= nearestDistance || (maxDistance && distance > maxDistance))
-            continue;
+            WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, candidate.second);
+            if (!worldObj)
+                continue;
 
-        LootObject lootObject(bot, guid);
+            if (maxDistance && bot->GetDistance(worldObj) > maxDistance)
+                continue;
 
-        if (!lootObject.IsLootPossible(bot))
-            continue;
+            uint32 const lootState = GetLootState(worldObj);
+            if (!lootState)
+                continue;
+
+            // The bot's quests and skills are taken as unchanged for the 30 seconds a target is kept
+            LootTarget& target = targets.at(candidate.second);
+            if (target.lootState != lootState)
+            {
+                target.loot.Refresh(bot, target.guid);
+                target.lootState = lootState;
+            }
 
-        nearestDistance = distance;
-        nearest = lootObject;
+            if (!target.loot.IsLootPossible(bot, worldObj))
+                continue;
+
+            nearestDistance = candidate.first;
+            nearest = target.loot;
+            break;
+        }
     }
 
     return nearest;
@@ -6,6 +6,11 @@
 #ifndef _PLAYERBOT_LOOTOBJECTSTACK_H
 #define _PLAYERBOT_LOOTOBJECTSTACK_H
 
+#include <cmath>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 #include "ObjectGuid.h"
 
 class AiObjectContext;
@@ -33,6 +38,8 @@ public:
 
     bool IsEmpty() { return !guid; }
     bool IsLootPossible(Player* bot);
+    // Same checks for an object already resolved and refreshed by the caller
+    bool IsLootPossible(Player* bot, WorldObject* worldObj);
     void Refresh(Player* bot, ObjectGuid guid);
     WorldObject* GetWorldObject(Player* bot);
     ObjectGuid guid;
@@ -49,23 +56,23 @@ class LootTarget
 {
 public:
     LootTarget(ObjectGuid guid);
-    LootTarget(LootTarget const& other);
-
-public:
-    LootTarget& operator=(LootTarget const& other);
-    bool operator<(LootTarget const& other) const;
 
-public:
     ObjectGuid guid;
     time_t asOfTime;
-};
 
-class LootTargetList : public std::set<LootTarget>
-{
-public:
-    void shrink(time_t fromTime);
+    // Set once the target is a corpse or an object, which no longer moves
+    bool located;
+    float x;
+    float y;
+    float z;
+
+    // Refresh result, kept while the loot state of the target stays the same
+    LootObject loot;
+    uint32 lootState;
 };
 
+// Loot targets of a bot. Targets are located once they stop moving and kept in a coarse grid, so the nearest one is
+// found by walking the cells outwards from the bot and resolving only the targets that could still be nearer.
 class LootObjectStack
 {
 public:
@@ -78,10 +85,22 @@ public:
     LootObject GetLoot(float maxDistance = 0);
 
 private:
+    static float constexpr CELL_SIZE = 20.0f;
+
+    static int32 GetCellCoord(float value) { return int32(std::floor(value / CELL_SIZE)); }
+    static uint64 GetCellKey(int32 x, int32 y) { return (uint64(uint32(x)) << 32) | uint32(y); }
+    static uint32 GetLootState(WorldObject* worldObj);
+
     LootObject GetNearest(float maxDistance = 0);
+    void Shrink(time_t fromTime);
+    void Locate();
+    void Erase(std::unordered_map<ObjectGuid, LootTarget>::iterator itr);
 
     Player* bot;
-    LootTargetList availableLoot;
+    std::unordered_map<ObjectGuid, LootTarget> targets;
+    std::deque<std::pair<time_t, ObjectGuid>> expiry;           // in the order the targets were added
+    std::vector<ObjectGuid> unlocated;                           // still alive when added
+    std::unordered_map<uint64, std::vector<ObjectGuid>> cells;  // located targets per cell
 };
 
 #endif
@@ -447,9 +447,16 @@ bool RandomItemMgr::CheckItemStats(uint8 clazz, uint8 sp, uint8 ap, uint8 tank)
     return sp || ap || tank;
 }
 
-std::vector<uint32> RandomItemMgr::GetCachedEquipments(uint32 requiredLevel, uint32 inventoryType)
+std::vector<uint32> const& RandomItemMgr::GetCachedEquipments(uint32 requiredLevel, uint32 inventoryType)
 {
-    return equipCacheNew[requiredLevel][inventoryType];
+    static std::vector<uint32> const empty;
+
+    auto level = equipCacheNew.find(requiredLevel);
+    if (level == equipCacheNew.end())
+        return empty;
+
+    auto items = level->second.find(inventoryType);
+    return items != level->second.end() ? items->second : empty;
 }
 
 bool RandomItemMgr::ShouldEquipArmorForSpec(uint8 playerclass, uint8 spec, ItemTemplate const* proto)
@@ -926,36 +933,6 @@ void RandomItemMgr::BuildItemInfoCache()
 
     LOG_INFO("playerbots", "Loaded {} vendor items...", vendorItems.size());
 
-    // calculate drop source
-    LOG_INFO("playerbots", "Loading loot templates...");
-    DropMap* dropMap = new DropMap;
-
-    if (CreatureTemplateContainer const* creatures = sObjectMgr->GetCreatureTemplates())
-    {
-        for (CreatureTemplateContainer::const_iterator itr = creatures->begin(); itr != creatures->end(); ++itr)
-        {
-            uint32 sEntry = itr->first;
-            if (LootTemplateAccess const* lTemplateA =
-                    DropMapValue::GetLootTemplate(ObjectGuid::Create<HighGuid::Unit>(sEntry, uint32(1)), LOOT_CORPSE))
-                for (auto const& lItem : lTemplateA->Entries)
-                    dropMap->insert(std::make_pair(lItem->itemid, sEntry));
-        }
-    }
-
-    if (GameObjectTemplateContainer const* gameobjects = sObjectMgr->GetGameObjectTemplates())
-    {
-        for (auto const& itr : *gameobjects)
-        {
-            uint32 sEntry = itr.first;
-            if (LootTemplateAccess const* lTemplateA = DropMapValue::GetLootTemplate(
-                    ObjectGuid::Create<HighGuid::GameObject>(sEntry, uint32(1)), LOOT_CORPSE))
-                for (auto const& lItem : lTemplateA->Entries)
-                    dropMap->insert(std::make_pair(lItem->itemid, sEntry));
-        }
-    }
-
-    LOG_INFO("playerbots", "Loaded {} loot templates...", dropMap->size());
-
     ItemTemplateContainer const* itemTemplate = sObjectMgr->GetItemTemplateStore();
     LOG_INFO("playerbots", "Calculating stat weights for {} items...", itemTemplate->size());
 
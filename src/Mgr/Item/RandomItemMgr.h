@@ -173,7 +173,8 @@ public:
     std::vector<uint32> GetQuestIdsForItem(uint32 itemId);
     static bool IsUsedBySkill(ItemTemplate const* proto, uint32 skillId);
     bool IsTestItem(uint32 itemId) { return itemForTest.find(itemId) != itemForTest.end(); }
-    std::vector<uint32> GetCachedEquipments(uint32 requiredLevel, uint32 inventoryType);
+    // Read only, safe to call from any thread once the cache is built
+    std::vector<uint32> const& GetCachedEquipments(uint32 requiredLevel, uint32 inventoryType);
 
 private:
     void BuildRandomItemCache();
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "ReagentSpellIndex.h"
+
+#include <algorithm>
+
+#include "Chat.h"
+#include "Log.h"
+#include "Player.h"
+#include "PlayerbotStateVersions.h"
+#include "SpellInfo.h"
+#include "SpellMgr.h"
+#include "Timer.h"
+
+void ReagentSpellIndex::Build()
+{
+    uint32 const oldMSTime = getMSTime();
+
+    // reagent, spell bit
+    std::vector<std::pair<uint32, uint32>> links;
+
+    spells.clear();
+    for (uint32 spellId = 1; spellId < sSpellMgr->GetSpellInfoStoreSize(); ++spellId)
+    {
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo || spellInfo->IsPassive() || spellInfo->Effects[EFFECT_0].Effect != SPELL_EFFECT_CREATE_ITEM)
+            continue;
+
+        uint32 const bit = spells.size();
+        for (uint8 i = 0; i < MAX_SPELL_REAGENTS; i++)
+            if (spellInfo->ReagentCount[i] > 0 && spellInfo->Reagent[i])
+                links.emplace_back(spellInfo->Reagent[i], bit);
+
+        if (!links.empty() && links.back().second == bit)
+            spells.push_back(spellId);
+    }
+
+    // A spell listing the same reagent twice is still one spell using it
+    std::sort(links.begin(), links.end());
+    links.erase(std::unique(links.begin(), links.end()), links.end());
+
+    reagentKeys.clear();
+    reagentOffsets.clear();
+    reagentSpells.clear();
+    reagentSpells.reserve(links.size());
+    for (std::pair<uint32, uint32> const& link : links)
+    {
+        if (reagentKeys.empty() || reagentKeys.back() != link.first)
+        {
+            reagentKeys.push_back(link.first);
+            reagentOffsets.push_back(reagentSpells.size());
+        }
+
+        reagentSpells.push_back(link.second);
+    }
+    reagentOffsets.push_back(reagentSpells.size());
+
+    spells.shrink_to_fit();
+    reagentKeys.shrink_to_fit();
+    reagentOffsets.shrink_to_fit();
+
+    built = true;
+
+    LOG_INFO("playerbots", ">> Reagent spell index built: {} spells, {} reagents, {} links in {} ms", spells.size(),
+             reagentKeys.size(), reagentSpells.size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+std::vector<uint32> ReagentSpellIndex::GetSpellsUsingItem(Player* player, uint32 itemId)
+{
+    std::vector<uint32> result;
+
+    std::vector<uint32>::const_iterator key = std::lower_bound(reagentKeys.begin(), reagentKeys.end(), itemId);
+    if (key == reagentKeys.end() || *key != itemId)
+        return result;
+
+    ++queries;
+
+    uint32 const index = std::distance(reagentKeys.cbegin(), key);
+    uint32 const version = sPlayerbotStateVersions->Get(player->GetGUID()).counters[PLAYER_STATE_SPELLS];
+
+    Shard& shard = GetShard(player->GetGUID());
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    // Spells added without the learn hook (loading, factory) still change the spell count
+    KnownSpells& known = shard.rows[player->GetGUID()];
+    if (known.bits.empty() || known.version != version || known.spellCount != player->GetSpellMap().size())
+    {
+        known.version = version;
+        Collect(player, known);
+    }
+
+    for (uint32 i = reagentOffsets[index]; i < reagentOffsets[index + 1]; ++i)
+    {
+        uint32 const bit = reagentSpells[i];
+        if (known.bits[bit / 64] & (uint64(1) << (bit % 64)))
+            result.push_back(spells[bit]);
+    }
+
+    return result;
+}
+
+void ReagentSpellIndex::Collect(Player* player, KnownSpells& known)
+{
+    ++collects;
+
+    PlayerSpellMap const& spellMap = player->GetSpellMap();
+    known.spellCount = spellMap.size();
+    known.bits.assign(spells.size() / 64 + 1, 0);
+
+    for (auto const& spell : spellMap)
+    {
+        if (spell.second->State == PLAYERSPELL_REMOVED || !spell.second->Active)
+            continue;
+
+        std::vector<uint32>::const_iterator itr = std::lower_bound(spells.begin(), spells.end(), spell.first);
+        if (itr == spells.end() || *itr != spell.first)
+            continue;
+
+        uint32 const bit = std::distance(spells.cbegin(), itr);
+        known.bits[bit / 64] |= uint64(1) << (bit % 64);
+    }
+}
+
+void ReagentSpellIndex::OnLogout(ObjectGuid guid)
+{
+    Shard& shard = GetShard(guid);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.rows.erase(guid);
+}
+
+void ReagentSpellIndex::PrintStats(ChatHandler* handler) const
+{
+    uint32 rows = 0;
+    for (Shard const& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        rows += shard.rows.size();
+    }
+
+    handler->PSendSysMessage("Reagent spell index: {} spells, {} reagents, {} links", spells.size(),
+                             reagentKeys.size(), reagentSpells.size());
+    handler->PSendSysMessage("Known spell sets: {} players, {} reagent queries, {} collected", rows, queries.load(),
+                             collects.load());
+}
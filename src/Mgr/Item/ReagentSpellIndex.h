@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_REAGENTSPELLINDEX_H
+#define _PLAYERBOT_REAGENTSPELLINDEX_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class ChatHandler;
+class Player;
+
+// Reagent -> create item spell index built once at startup from the spell store, stored CSR style like LootIndex.
+// Crafting spells are numbered densely, and per player a bitset of the ones it knows is kept until its spells or
+// skills change (see PlayerbotStateVersions), so the spells using a reagent are found by testing the few spells
+// that list it instead of walking the whole spell book.
+class ReagentSpellIndex
+{
+public:
+    static ReagentSpellIndex* instance()
+    {
+        static ReagentSpellIndex instance;
+        return &instance;
+    }
+
+    void Build();
+    bool IsBuilt() const { return built; }
+
+    // Known, active create item spells using the item as a reagent. Map thread of the player.
+    std::vector<uint32> GetSpellsUsingItem(Player* player, uint32 itemId);
+    void OnLogout(ObjectGuid guid);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    ReagentSpellIndex() {}
+
+    static uint32 const SHARD_COUNT = 16;
+
+    struct KnownSpells
+    {
+        uint32 version = 0;  // PLAYER_STATE_SPELLS counter the bits were collected at
+        uint32 spellCount = 0;
+        std::vector<uint64> bits;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<ObjectGuid, KnownSpells> rows;
+    };
+
+    Shard& GetShard(ObjectGuid guid) { return shards[guid.GetCounter() % SHARD_COUNT]; }
+
+    void Collect(Player* player, KnownSpells& known);
+
+    bool built = false;
+
+    std::vector<uint32> spells;  // crafting spell ids, sorted, the position is the spell's bit
+    std::vector<uint32> reagentKeys;
+    std::vector<uint32> reagentOffsets;
+    std::vector<uint32> reagentSpells;  // bits of the spells using the reagent
+
+    Shard shards[SHARD_COUNT];
+
+    std::atomic<uint64> queries{0};
+    std::atomic<uint64> collects{0};
+};
+
+#define sReagentSpellIndex ReagentSpellIndex::instance()
+
+#endif
@@ -6,6 +6,8 @@
 #ifndef _PLAYERBOT_STATSCOLLECTOR_H
 #define _PLAYERBOT_STATSCOLLECTOR_H
 
+#include <array>
+
 #include "ItemTemplate.h"
 #include "SpellInfo.h"
 
@@ -47,6 +49,9 @@ enum StatsType : uint8
     STATS_TYPE_MAX = 26
 };
 
+// Stats of one item or enchant as collected by a StatsCollector, kept to weigh them later
+typedef std::array<float, STATS_TYPE_MAX> CollectedStats;
+
 enum CollectorType : uint8
 {
     MELEE_DMG = 1,
@@ -5,6 +5,7 @@
 
 #include "StatsWeightCalculator.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "AiFactory.h"
@@ -75,6 +76,23 @@ float StatsWeightCalculator::CalculateItem(uint32 itemId, int32 randomPropertyId
     if (randomPropertyIds != 0)
         CalculateRandomProperty(randomPropertyIds, itemId);
 
+    return WeighItem(proto);
+}
+
+float StatsWeightCalculator::CalculateCollectedItem(uint32 itemId, CollectedStats const& stats)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemId);
+    if (!proto)
+        return 0.0f;
+
+    Reset();
+    std::copy(stats.begin(), stats.end(), collector_->stats);
+
+    return WeighItem(proto);
+}
+
+float StatsWeightCalculator::WeighItem(ItemTemplate const* proto)
+{
     if (enable_overflow_penalty_)
         ApplyOverflowPenalty(player_);
 
@@ -118,6 +136,19 @@ float StatsWeightCalculator::CalculateEnchant(uint32 enchantId)
 
     collector_->CollectEnchantStats(enchant);
 
+    return WeighEnchant();
+}
+
+float StatsWeightCalculator::CalculateCollectedEnchant(CollectedStats const& stats)
+{
+    Reset();
+    std::copy(stats.begin(), stats.end(), collector_->stats);
+
+    return WeighEnchant();
+}
+
+float StatsWeightCalculator::WeighEnchant()
+{
     if (enable_overflow_penalty_)
         ApplyOverflowPenalty(player_);
 
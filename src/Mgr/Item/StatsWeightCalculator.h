@@ -30,6 +30,11 @@ public:
     void Reset();
     float CalculateItem(uint32 itemId, int32 randomPropertyId = 0);
     float CalculateEnchant(uint32 enchantId);
+    // Same as above for stats collected beforehand by a StatsCollector of GetCollectorType() and the player's class
+    float CalculateCollectedItem(uint32 itemId, CollectedStats const& stats);
+    float CalculateCollectedEnchant(CollectedStats const& stats);
+
+    CollectorType GetCollectorType() const { return type_; }
 
     void SetOverflowPenalty(bool apply) { enable_overflow_penalty_ = apply; }
     void SetItemSetBonus(bool apply) { enable_item_set_bonus_ = apply; }
@@ -40,6 +45,9 @@ public:
     void GenerateBasicWeights(Player* player);
     void GenerateAdditionalWeights(Player* player);
 
+    float WeighItem(ItemTemplate const* proto);
+    float WeighEnchant();
+
     void CalculateRandomProperty(int32 randomPropertyId, uint32 itemId);
     void CalculateItemSetMod(Player* player, ItemTemplate const* proto);
     void CalculateSocketBonus(Player* player, ItemTemplate const* proto);
@@ -5,6 +5,9 @@
 
 #include "FleeManager.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Playerbots.h"
 #include "ServerFacade.h"
 
@@ -18,32 +21,61 @@ FleeManager::FleeManager(Player* bot, float maxAllowedDistance, float followAngl
 {
 }
 
-void FleeManager::calculateDistanceToCreatures(FleePoint* point)
+void FleeManager::collectEnemies(FleeEnemies& enemies, std::vector<float>& enemyOri)
 {
-    point->minDistance = -1.0f;
-    point->sumDistance = 0.0f;
     PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
     if (!botAI)
     {
         return;
     }
-    GuidVector units = *botAI->GetAiObjectContext()->GetValue<GuidVector>("possible targets no los");
-    for (GuidVector::iterator i = units.begin(); i != units.end(); ++i)
+    GuidVector const& units = *botAI->GetAiObjectContext()->GetValue<GuidVector>("possible targets no los");
+    for (GuidVector::const_iterator i = units.begin(); i != units.end(); ++i)
     {
         Unit* unit = botAI->GetUnit(*i);
         if (!unit)
             continue;
 
-        float d = sServerFacade->GetDistance2d(unit, point->x, point->y);
-        point->sumDistance += d;
-        if (point->minDistance < 0 || point->minDistance > d)
-            point->minDistance = d;
+        enemies.x.push_back(unit->GetPositionX());
+        enemies.y.push_back(unit->GetPositionY());
+        enemies.size.push_back(unit->GetObjectSize());
+        enemyOri.push_back(bot->GetAngle(unit));
     }
 }
 
-bool intersectsOri(float angle, std::vector<float>& angles, float angleIncrement)
+// Same distance as ServerFacade::GetDistance2d(unit, x, y): 2d distance minus the unit size, rounded to 0.1.
+// Enemies are the outer loop so the inner loop is a plain pass over the point arrays the compiler can vectorize.
+void FleeManager::calculateDistanceToCreatures(FleePoints& points, FleeEnemies const& enemies)
 {
-    for (std::vector<float>::iterator i = angles.begin(); i != angles.end(); ++i)
+    size_t const count = points.x.size();
+    points.minDistance.assign(count, -1.0f);
+    points.sumDistance.assign(count, 0.0f);
+
+    float const* px = points.x.data();
+    float const* py = points.y.data();
+    float* minDistance = points.minDistance.data();
+    float* sumDistance = points.sumDistance.data();
+    for (size_t e = 0; e < enemies.x.size(); ++e)
+    {
+        float const ex = enemies.x[e];
+        float const ey = enemies.y[e];
+        float const size = enemies.size[e];
+        for (size_t i = 0; i < count; ++i)
+        {
+            float const dx = px[i] - ex;
+            float const dy = py[i] - ey;
+            float d = std::sqrt(dx * dx + dy * dy) - size;
+            d = d > 0.0f ? d : 0.0f;
+            d = std::round(d * 10.0f) / 10.0f;
+
+            sumDistance[i] += d;
+            minDistance[i] = (minDistance[i] < 0.0f || minDistance[i] > d) ? d : minDistance[i];
+        }
+    }
+}
+
+bool intersectsOri(float angle, std::vector<float> const& angles, float angleIncrement)
+{
+    for (std::vector<float>::const_iterator i = angles.begin(); i != angles.end(); ++i)
     {
         float ori = *i;
         if (abs(angle - ori) < angleIncrement)
@@ -53,33 +85,11 @@ bool intersectsOri(float angle, std::vector<float>& angles, float angleIncrement
     return false;
 }
 
-void FleeManager::calculatePossibleDestinations(std::vector<FleePoint*>& points)
+// Only positions here, height, water and line of sight are checked for the best scored points only
+void FleeManager::calculatePossibleDestinations(FleePoints& points, std::vector<float> const& enemyOri)
 {
-    PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
-    if (!botAI)
-    {
-        return;
-    }
-    Unit* target = *botAI->GetAiObjectContext()->GetValue<Unit*>("current target");
-
     float botPosX = startPosition.getX();
     float botPosY = startPosition.getY();
-    float botPosZ = startPosition.getZ();
-
-    FleePoint start(botAI, botPosX, botPosY, botPosZ);
-    calculateDistanceToCreatures(&start);
-
-    std::vector<float> enemyOri;
-    GuidVector units = *botAI->GetAiObjectContext()->GetValue<GuidVector>("possible targets no los");
-    for (GuidVector::iterator i = units.begin(); i != units.end(); ++i)
-    {
-        Unit* unit = botAI->GetUnit(*i);
-        if (!unit)
-            continue;
-
-        float ori = bot->GetAngle(unit);
-        enemyOri.push_back(ori);
-    }
 
     float distIncrement = std::max(sPlayerbotAIConfig->followDistance,
                                    (maxAllowedDistance - sPlayerbotAIConfig->tooCloseDistance) / 10.0f);
@@ -94,81 +104,74 @@ void FleeManager::calculatePossibleDestinations(std::vector<FleePoint*>& points)
                 if (intersectsOri(angle, enemyOri, angleIncrement))
                     continue;
 
-                float x = botPosX + cos(angle) * maxAllowedDistance, y = botPosY + sin(angle) * maxAllowedDistance,
-                      z = botPosZ + CONTACT_DISTANCE;
+                float x = botPosX + cos(angle) * maxAllowedDistance, y = botPosY + sin(angle) * maxAllowedDistance;
                 if (forceMaxDistance &&
                     sServerFacade->IsDistanceLessThan(sServerFacade->GetDistance2d(bot, x, y),
                                                       maxAllowedDistance - sPlayerbotAIConfig->tooCloseDistance))
                     continue;
 
-                bot->UpdateAllowedPositionZ(x, y, z);
-
-                Map* map = startPosition.getMap();
-                if (map && map->IsInWater(bot->GetPhaseMask(), x, y, z, bot->GetCollisionHeight()))
-                    continue;
-
-                if (!bot->IsWithinLOS(x, y, z) || (target && !target->IsWithinLOS(x, y, z)))
-                    continue;
-
-                FleePoint* point = new FleePoint(botAI, x, y, z);
-                calculateDistanceToCreatures(point);
-
-                if (sServerFacade->IsDistanceGreaterOrEqualThan(point->minDistance - start.minDistance,
-                                                                sPlayerbotAIConfig->followDistance))
-                    points.push_back(point);
-                else
-                    delete point;
+                points.Add(x, y);
             }
         }
     }
 }
 
-void FleeManager::cleanup(std::vector<FleePoint*>& points)
+bool FleeManager::selectOptimalDestination(FleePoints const& points, float startMinDistance, float* rx, float* ry,
+                                           float* rz)
 {
-    for (std::vector<FleePoint*>::iterator i = points.begin(); i != points.end(); i++)
+    std::vector<uint32> ranked;
+    for (uint32 i = 0; i < points.x.size(); ++i)
     {
-        delete *i;
+        if (sServerFacade->IsDistanceGreaterOrEqualThan(points.minDistance[i] - startMinDistance,
+                                                        sPlayerbotAIConfig->followDistance))
+            ranked.push_back(i);
     }
 
-    points.clear();
-}
-
-bool FleeManager::isBetterThan(FleePoint* point, FleePoint* other)
-{
-    return point->sumDistance - other->sumDistance > 0;
-}
+    // Farthest from all enemies first, ties keep the order the points were generated in
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [&points](uint32 a, uint32 b) { return points.sumDistance[a] > points.sumDistance[b]; });
 
-FleePoint* FleeManager::selectOptimalDestination(std::vector<FleePoint*>& points)
-{
-    FleePoint* best = nullptr;
-    for (std::vector<FleePoint*>::iterator i = points.begin(); i != points.end(); i++)
+    PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+    Unit* target = botAI ? *botAI->GetAiObjectContext()->GetValue<Unit*>("current target") : nullptr;
+    Map* map = startPosition.getMap();
+    for (uint32 i : ranked)
     {
-        FleePoint* point = *i;
-        if (!best || isBetterThan(point, best))
-            best = point;
+        float x = points.x[i], y = points.y[i], z = startPosition.getZ() + CONTACT_DISTANCE;
+        bot->UpdateAllowedPositionZ(x, y, z);
+
+        if (map && map->IsInWater(bot->GetPhaseMask(), x, y, z, bot->GetCollisionHeight()))
+            continue;
+
+        if (!bot->IsWithinLOS(x, y, z) || (target && !target->IsWithinLOS(x, y, z)))
+            continue;
+
+        *rx = x;
+        *ry = y;
+        *rz = z;
+        return true;
     }
 
-    return best;
+    return false;
 }
 
 bool FleeManager::CalculateDestination(float* rx, float* ry, float* rz)
 {
-    std::vector<FleePoint*> points;
-    calculatePossibleDestinations(points);
-
-    FleePoint* point = selectOptimalDestination(points);
-    if (!point)
-    {
-        cleanup(points);
+    if (!GET_PLAYERBOT_AI(bot))
         return false;
-    }
 
-    *rx = point->x;
-    *ry = point->y;
-    *rz = point->z;
+    FleeEnemies enemies;
+    std::vector<float> enemyOri;
+    collectEnemies(enemies, enemyOri);
+
+    FleePoints start;
+    start.Add(startPosition.getX(), startPosition.getY());
+    calculateDistanceToCreatures(start, enemies);
+
+    FleePoints points;
+    calculatePossibleDestinations(points, enemyOri);
+    calculateDistanceToCreatures(points, enemies);
 
-    cleanup(points);
-    return true;
+    return selectOptimalDestination(points, start.minDistance[0], rx, ry, rz);
 }
 
 bool FleeManager::isUseful()
@@ -12,25 +12,28 @@
 #include "TravelMgr.h"
 
 class Player;
-class PlayerbotAI;
 
-class FleePoint
+// Candidate flee points as parallel arrays, the distance scoring runs over all of them in one loop per enemy
+struct FleePoints
 {
-public:
-    FleePoint(PlayerbotAI* botAI, float x, float y, float z)
-        : x(x), y(y), z(z), sumDistance(0.0f), minDistance(0.0f), botAI(botAI)
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> minDistance;
+    std::vector<float> sumDistance;
+
+    void Add(float px, float py)
     {
+        x.push_back(px);
+        y.push_back(py);
     }
+};
 
-    float x;
-    float y;
-    float z;
-
-    float sumDistance;
-    float minDistance;
-
-private:
-    PlayerbotAI* botAI;
+// Positions and object sizes of the possible targets, read once per flee calculation
+struct FleeEnemies
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> size;
 };
 
 class FleeManager
@@ -43,11 +46,10 @@ public:
     bool isUseful();
 
 private:
-    void calculatePossibleDestinations(std::vector<FleePoint*>& points);
-    void calculateDistanceToCreatures(FleePoint* point);
-    void cleanup(std::vector<FleePoint*>& points);
-    FleePoint* selectOptimalDestination(std::vector<FleePoint*>& points);
-    bool isBetterThan(FleePoint* point, FleePoint* other);
+    void collectEnemies(FleeEnemies& enemies, std::vector<float>& enemyOri);
+    void calculatePossibleDestinations(FleePoints& points, std::vector<float> const& enemyOri);
+    static void calculateDistanceToCreatures(FleePoints& points, FleeEnemies const& enemies);
+    bool selectOptimalDestination(FleePoints const& points, float startMinDistance, float* rx, float* ry, float* rz);
 
     Player* bot;
     float maxAllowedDistance;
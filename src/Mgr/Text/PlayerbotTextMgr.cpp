@@ -5,9 +5,115 @@
 
 #include "PlayerbotTextMgr.h"
 
+#include <cctype>
+
+#include "Chat.h"
 #include "Playerbots.h"
+#include "Timer.h"
 #include "WorldSessionMgr.h"
 
+static std::map<std::string, std::string> const noPlaceholders;
+
+// Length of the placeholder (%name or <name>) starting at pos, 0 when there is none
+static uint32 GetPlaceholderLength(std::string const& text, uint32 pos)
+{
+    if (text[pos] != '%' && text[pos] != '<')
+        return 0;
+
+    uint32 end = pos + 1;
+    while (end < text.size() && (std::isalnum(uint8(text[end])) || text[end] == '_'))
+        ++end;
+
+    if (end == pos + 1)
+        return 0;
+
+    if (text[pos] == '%')
+        return end - pos;
+
+    return end < text.size() && text[end] == '>' ? end + 1 - pos : 0;
+}
+
+BotTextTemplate BotTextTemplate::Compile(std::string const& text)
+{
+    BotTextTemplate compiled;
+    compiled.text = text;
+
+    uint32 literal = 0;
+    for (uint32 pos = 0; pos < text.size();)
+    {
+        uint32 const length = GetPlaceholderLength(text, pos);
+        if (!length)
+        {
+            ++pos;
+            continue;
+        }
+
+        if (pos > literal)
+            compiled.tokens.push_back({literal, pos - literal, false});
+
+        compiled.tokens.push_back({pos, length, true});
+        pos += length;
+        literal = pos;
+    }
+
+    if (literal < text.size())
+        compiled.tokens.push_back({literal, uint32(text.size()) - literal, false});
+
+    return compiled;
+}
+
+void BotTextTemplate::Render(std::string& out, std::map<std::string, std::string> const& placeholders) const
+{
+    // Keys that are not %name or <name> can match anywhere in the text, only replaceAll handles those
+    for (auto const& placeholder : placeholders)
+    {
+        if (placeholder.first.empty() || GetPlaceholderLength(placeholder.first, 0) != placeholder.first.size())
+        {
+            std::string replaced = text;
+            for (auto const& itr : placeholders)
+                PlayerbotTextMgr::replaceAll(replaced, itr.first, itr.second);
+
+            out += replaced;
+            return;
+        }
+    }
+
+    for (Token const& token : tokens)
+    {
+        if (!token.placeholder || placeholders.empty())
+        {
+            out.append(text, token.offset, token.length);
+            continue;
+        }
+
+        std::string const name = text.substr(token.offset, token.length);
+        auto itr = placeholders.find(name);
+        if (itr != placeholders.end())
+        {
+            out += itr->second;
+            continue;
+        }
+
+        // Texts may run a shorter key into other letters, e.g. "%s" in "%ss"
+        auto prefix = placeholders.end();
+        for (auto i = placeholders.begin(); i != placeholders.end(); ++i)
+        {
+            if (i->first.size() < name.size() && !name.compare(0, i->first.size(), i->first) &&
+                (prefix == placeholders.end() || i->first.size() > prefix->first.size()))
+                prefix = i;
+        }
+
+        if (prefix == placeholders.end())
+        {
+            out += name;
+            continue;
+        }
+
+        out += prefix->second;
+        out.append(name, prefix->first.size(), std::string::npos);
+    }
+}
+
 void PlayerbotTextMgr::replaceAll(std::string& str, const std::string& from, const std::string& to)
 {
     if (from.empty())
@@ -30,15 +136,15 @@ void PlayerbotTextMgr::LoadBotTexts()
     {
         do
         {
-            std::map<uint32, std::string> text;
+            std::vector<BotTextTemplate> text(MAX_LOCALES);
             Field* fields = result->Fetch();
             std::string name = fields[0].Get<std::string>();
-            text[0] = fields[1].Get<std::string>();
+            text[0] = BotTextTemplate::Compile(fields[1].Get<std::string>());
             uint8 sayType = fields[2].Get<uint8>();
             uint8 replyType = fields[3].Get<uint8>();
             for (uint8 i = 1; i < MAX_LOCALES; ++i)
             {
-                text[i] = fields[i + 3].Get<std::string>();
+                text[i] = BotTextTemplate::Compile(fields[i + 3].Get<std::string>());
             }
 
             botTexts[name].push_back(BotTextEntry(name, text, sayType, replyType));
@@ -46,6 +152,12 @@ void PlayerbotTextMgr::LoadBotTexts()
         } while (result->NextRow());
     }
 
+    botReplies.clear();
+    auto replies = botTexts.find("reply");
+    if (replies != botTexts.end())
+        for (BotTextEntry const& entry : replies->second)
+            botReplies[entry.m_replyType].push_back(&entry);
+
     LOG_INFO("playerbots", "{} playerbots texts loaded", count);
 }
 
@@ -70,48 +182,55 @@ void PlayerbotTextMgr::LoadBotTextChance()
 
 // general texts
 
-std::string PlayerbotTextMgr::GetBotText(std::string name)
+BotTextEntry const* PlayerbotTextMgr::SelectBotText(std::string const& name)
 {
     if (botTexts.empty())
     {
         LOG_ERROR("playerbots", "Can't get bot text {}! No bots texts loaded!", name);
-        return "";
+        return nullptr;
     }
 
-    if (botTexts[name].empty())
+    auto list = botTexts.find(name);
+    if (list == botTexts.end() || list->second.empty())
     {
         LOG_ERROR("playerbots", "Can't get bot text {}! No bots texts for this name!", name);
-        return "";
+        return nullptr;
     }
 
-    std::vector<BotTextEntry>& list = botTexts[name];
-    BotTextEntry textEntry = list[urand(0, list.size() - 1)];
-    return !textEntry.m_text[GetLocalePriority()].empty() ? textEntry.m_text[GetLocalePriority()] : textEntry.m_text[0];
+    return &list->second[urand(0, list->second.size() - 1)];
 }
 
-std::string PlayerbotTextMgr::GetBotText(std::string name, std::map<std::string, std::string> placeholders)
+std::string PlayerbotTextMgr::Render(BotTextEntry const& entry, std::map<std::string, std::string> const& placeholders)
 {
-    std::string botText = GetBotText(name);
-    if (botText.empty())
-        return "";
+    BotTextTemplate const& text = entry.GetText(GetLocalePriority());
+    if (placeholders.empty())
+        return text.text;
+
+    static thread_local std::string buffer;
+    buffer.clear();
+    text.Render(buffer, placeholders);
+    return buffer;
+}
 
-    for (std::map<std::string, std::string>::iterator i = placeholders.begin(); i != placeholders.end(); ++i)
-        replaceAll(botText, i->first, i->second);
+std::string PlayerbotTextMgr::GetBotText(std::string name)
+{
+    BotTextEntry const* entry = SelectBotText(name);
+    return entry ? Render(*entry, noPlaceholders) : "";
+}
 
-    return botText;
+std::string PlayerbotTextMgr::GetBotText(std::string name, std::map<std::string, std::string> const& placeholders)
+{
+    BotTextEntry const* entry = SelectBotText(name);
+    return entry ? Render(*entry, placeholders) : "";
 }
 
 std::string PlayerbotTextMgr::GetBotTextOrDefault(std::string name, std::string defaultText,
-    std::map<std::string, std::string> placeholders)
+    std::map<std::string, std::string> const& placeholders)
 {
     std::string botText = GetBotText(name, placeholders);
     if (botText.empty())
     {
-        for (std::map<std::string, std::string>::iterator i = placeholders.begin(); i != placeholders.end(); ++i)
-        {
-            replaceAll(defaultText, i->first, i->second);
-        }
-        return defaultText;
+        BotTextTemplate::Compile(defaultText).Render(botText, placeholders);
     }
 
     return botText;
@@ -119,37 +238,32 @@ std::string PlayerbotTextMgr::GetBotTextOrDefault(std::string name, std::string
 
 // chat replies
 
-std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::map<std::string, std::string> placeholders)
+BotTextEntry const* PlayerbotTextMgr::SelectBotText(ChatReplyType replyType)
 {
     if (botTexts.empty())
     {
         LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts loaded!", replyType);
-        return "";
-    }
-    if (botTexts["reply"].empty())
-    {
-        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts replies!", replyType);
-        return "";
+        return nullptr;
     }
 
-    std::vector<BotTextEntry>& list = botTexts["reply"];
-    std::vector<BotTextEntry> proper_list;
-    for (auto text : list)
+    if (botTexts.find("reply") == botTexts.end())
     {
-        if (text.m_replyType == replyType)
-            proper_list.push_back(text);
+        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts replies!", replyType);
+        return nullptr;
     }
 
-    if (proper_list.empty())
-        return "";
+    auto list = botReplies.find(replyType);
+    if (list == botReplies.end() || list->second.empty())
+        return nullptr;
 
-    BotTextEntry textEntry = proper_list[urand(0, proper_list.size() - 1)];
-    std::string botText =
-        !textEntry.m_text[GetLocalePriority()].empty() ? textEntry.m_text[GetLocalePriority()] : textEntry.m_text[0];
-    for (auto& placeholder : placeholders)
-        replaceAll(botText, placeholder.first, placeholder.second);
+    return list->second[urand(0, list->second.size() - 1)];
+}
 
-    return botText;
+std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType,
+                                         std::map<std::string, std::string> const& placeholders)
+{
+    BotTextEntry const* entry = SelectBotText(replyType);
+    return entry ? Render(*entry, placeholders) : "";
 }
 
 std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::string name)
@@ -164,10 +278,11 @@ std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::string na
 
 bool PlayerbotTextMgr::rollTextChance(std::string name)
 {
-    if (!botTextChance[name])
+    auto chance = botTextChance.find(name);
+    if (chance == botTextChance.end() || !chance->second)
         return true;
 
-    return urand(0, 100) < botTextChance[name];
+    return urand(0, 100) < chance->second;
 }
 
 bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text)
@@ -179,7 +294,8 @@ bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text)
     return !text.empty();
 }
 
-bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text, std::map<std::string, std::string> placeholders)
+bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text,
+                                  std::map<std::string, std::string> const& placeholders)
 {
     if (!rollTextChance(name))
         return false;
@@ -226,3 +342,71 @@ void PlayerbotTextMgr::ResetLocalePriority()
         botTextLocalePriority[i] = 0;
     }
 }
+
+void PlayerbotTextMgr::PrintStats(ChatHandler* handler)
+{
+    // The placeholders most texts are said with
+    std::map<std::string, std::string> const placeholders = {
+        {"%s", "Somebody"},
+        {"%my_race", "Human"},
+        {"%my_level", "80"},
+        {"%my_class", "Warrior"},
+        {"%zone_name", "Dalaran"},
+        {"%area_name", "Krasus' Landing"},
+    };
+
+    uint32 texts = 0;
+    uint32 tokens = 0;
+    for (auto const& itr : botTexts)
+        for (BotTextEntry const& entry : itr.second)
+            for (BotTextTemplate const& text : entry.m_text)
+            {
+                if (text.empty())
+                    continue;
+
+                ++texts;
+                tokens += text.tokens.size();
+            }
+
+    if (!texts)
+    {
+        handler->PSendSysMessage("No bot texts loaded");
+        return;
+    }
+
+    uint32 const passes = 20;
+    uint64 rendered = 0;
+
+    uint32 const replaceStart = getMSTime();
+    for (uint32 pass = 0; pass < passes; ++pass)
+        for (auto const& itr : botTexts)
+            for (BotTextEntry const& entry : itr.second)
+                for (BotTextTemplate const& text : entry.m_text)
+                {
+                    std::string replaced = text.text;
+                    for (auto const& placeholder : placeholders)
+                        replaceAll(replaced, placeholder.first, placeholder.second);
+
+                    rendered += replaced.size();
+                }
+    uint32 const replaceTime = GetMSTimeDiffToNow(replaceStart);
+
+    uint32 const renderStart = getMSTime();
+    std::string buffer;
+    for (uint32 pass = 0; pass < passes; ++pass)
+        for (auto const& itr : botTexts)
+            for (BotTextEntry const& entry : itr.second)
+                for (BotTextTemplate const& text : entry.m_text)
+                {
+                    buffer.clear();
+                    text.Render(buffer, placeholders);
+                    rendered -= buffer.size();
+                }
+    uint32 const renderTime = GetMSTimeDiffToNow(renderStart);
+
+    handler->PSendSysMessage("{} texts in {} names, {} tokens", texts, botTexts.size(), tokens);
+    handler->PSendSysMessage("{} passes with {} placeholders: replaceAll {} ms, templates {} ms", passes,
+                             placeholders.size(), replaceTime, renderTime);
+    if (rendered)
+        handler->PSendSysMessage("Rendered length differs from replaceAll by {} characters", int64(rendered));
+}
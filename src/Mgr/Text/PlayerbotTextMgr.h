@@ -11,17 +11,46 @@
 
 #include "Common.h"
 
+class ChatHandler;
+
 #define BOT_TEXT1(name) sPlayerbotTextMgr->GetBotText(name)
 #define BOT_TEXT2(name, replace) sPlayerbotTextMgr->GetBotText(name, replace)
 
+// Bot text split at its placeholders (%name or <name>) once at load, so rendering is a single pass that looks up
+// each placeholder instead of searching the whole text once per placeholder
+struct BotTextTemplate
+{
+    struct Token
+    {
+        uint32 offset;
+        uint32 length;
+        bool placeholder;
+    };
+
+    std::string text;
+    std::vector<Token> tokens;
+
+    bool empty() const { return text.empty(); }
+    static BotTextTemplate Compile(std::string const& text);
+    // Appends to out, placeholders missing from the map are kept as written
+    void Render(std::string& out, std::map<std::string, std::string> const& placeholders) const;
+};
+
 struct BotTextEntry
 {
-    BotTextEntry(std::string name, std::map<uint32, std::string> text, uint32 say_type, uint32 reply_type)
+    BotTextEntry(std::string name, std::vector<BotTextTemplate> text, uint32 say_type, uint32 reply_type)
         : m_name(name), m_text(text), m_sayType(say_type), m_replyType(reply_type)
     {
     }
+
+    // Text in the given locale, the default locale when it has no translation
+    BotTextTemplate const& GetText(uint32 locale) const
+    {
+        return locale < m_text.size() && !m_text[locale].empty() ? m_text[locale] : m_text[0];
+    }
+
     std::string m_name;
-    std::map<uint32, std::string> m_text;
+    std::vector<BotTextTemplate> m_text;  // indexed by locale
     uint32 m_sayType;
     uint32 m_replyType;
 };
@@ -77,25 +106,32 @@ public:
         return &instance;
     }
 
-    std::string GetBotText(std::string name, std::map<std::string, std::string> placeholders);
+    std::string GetBotText(std::string name, std::map<std::string, std::string> const& placeholders);
     std::string GetBotText(std::string name);
-    std::string GetBotText(ChatReplyType replyType, std::map<std::string, std::string> placeholders);
+    std::string GetBotText(ChatReplyType replyType, std::map<std::string, std::string> const& placeholders);
     std::string GetBotText(ChatReplyType replyType, std::string name);
     bool GetBotText(std::string name, std::string& text);
-    bool GetBotText(std::string name, std::string& text, std::map<std::string, std::string> placeholders);
+    bool GetBotText(std::string name, std::string& text, std::map<std::string, std::string> const& placeholders);
     std::string GetBotTextOrDefault(std::string name, std::string defaultText,
-                                    std::map<std::string, std::string> placeholders);
+                                    std::map<std::string, std::string> const& placeholders);
     void LoadBotTexts();
     void LoadBotTextChance();
     static void replaceAll(std::string& str, const std::string& from, const std::string& to);
     bool rollTextChance(std::string text);
+    // Times rendering every loaded text through the templates against replaceAll
+    void PrintStats(ChatHandler* handler);
 
     uint32 GetLocalePriority();
     void AddLocalePriority(uint32 locale);
     void ResetLocalePriority();
 
 private:
+    BotTextEntry const* SelectBotText(std::string const& name);
+    BotTextEntry const* SelectBotText(ChatReplyType replyType);
+    std::string Render(BotTextEntry const& entry, std::map<std::string, std::string> const& placeholders);
+
     std::map<std::string, std::vector<BotTextEntry>> botTexts;
+    std::map<uint32, std::vector<BotTextEntry const*>> botReplies;  // "reply" texts by ChatReplyType
     std::map<std::string, uint32> botTextChance;
     uint32 botTextLocalePriority[MAX_LOCALES];
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "QuestPOIIndex.h"
+
+#include <algorithm>
+
+#include "Chat.h"
+#include "GridTerrainData.h"
+#include "IVMapMgr.h"
+#include "Log.h"
+#include "Map.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+#include "Random.h"
+#include "Timer.h"
+
+void QuestPOIIndex::Build()
+{
+    uint32 const oldMSTime = getMSTime();
+
+    std::vector<uint32> questIds;
+    for (auto const& itr : sObjectMgr->GetQuestTemplates())
+        if (sObjectMgr->GetQuestPOIVector(itr.first))
+            questIds.push_back(itr.first);
+
+    std::sort(questIds.begin(), questIds.end());
+
+    questKeys.clear();
+    questOffsets.clear();
+    pois.clear();
+    samples.clear();
+
+    for (uint32 questId : questIds)
+    {
+        uint32 const first = pois.size();
+        for (QuestPOI const& qPoi : *sObjectMgr->GetQuestPOIVector(questId))
+        {
+            if (qPoi.points.empty())
+                continue;
+
+            pois.push_back({qPoi.MapId, qPoi.ObjectiveIndex, uint32(samples.size())});
+
+            // Random points inside the area, weighted over its corners like the rpg actions always picked them
+            for (uint32 s = 0; s < SAMPLES_PER_POI; ++s)
+            {
+                std::vector<float> weights(qPoi.points.size());
+                float sum = 0.0f;
+                for (float& weight : weights)
+                {
+                    weight = rand_norm();
+                    sum += weight;
+                }
+
+                Sample sample = {0.0f, 0.0f};
+                for (uint32 i = 0; i < qPoi.points.size(); ++i)
+                {
+                    sample.x += qPoi.points[i].x * weights[i] / sum;
+                    sample.y += qPoi.points[i].y * weights[i] / sum;
+                }
+
+                samples.push_back(sample);
+            }
+        }
+
+        if (pois.size() == first)
+            continue;
+
+        questKeys.push_back(questId);
+        questOffsets.push_back(first);
+    }
+    questOffsets.push_back(pois.size());
+
+    questKeys.shrink_to_fit();
+    questOffsets.shrink_to_fit();
+    pois.shrink_to_fit();
+    samples.shrink_to_fit();
+
+    sampleZones.reset(new std::atomic<uint32>[samples.size()]);
+    for (uint32 i = 0; i < samples.size(); ++i)
+        sampleZones[i].store(ZONE_UNRESOLVED, std::memory_order_relaxed);
+
+    built = true;
+
+    LOG_INFO("playerbots", ">> Quest POI index built: {} quests, {} areas, {} samples in {} ms", questKeys.size(),
+             pois.size(), samples.size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+uint32 QuestPOIIndex::FindQuest(uint32 questId) const
+{
+    std::vector<uint32>::const_iterator itr = std::lower_bound(questKeys.begin(), questKeys.end(), questId);
+    if (itr == questKeys.end() || *itr != questId)
+        return questKeys.size();
+
+    return std::distance(questKeys.begin(), itr);
+}
+
+QuestPOILocation const* QuestPOIIndex::QuestBegin(uint32 questId) const
+{
+    uint32 const index = FindQuest(questId);
+    return index == questKeys.size() ? nullptr : pois.data() + questOffsets[index];
+}
+
+QuestPOILocation const* QuestPOIIndex::QuestEnd(uint32 questId) const
+{
+    uint32 const index = FindQuest(questId);
+    return index == questKeys.size() ? nullptr : pois.data() + questOffsets[index + 1];
+}
+
+bool QuestPOIIndex::SelectSample(Player* player, QuestPOILocation const& poi, float maxDistance, float& x, float& y)
+{
+    if (poi.mapId != player->GetMapId())
+        return false;
+
+    ++selects;
+
+    uint32 const zoneId = player->GetZoneId();
+    uint32 const offset = urand(0, SAMPLES_PER_POI - 1);
+    for (uint32 i = 0; i < SAMPLES_PER_POI; ++i)
+    {
+        uint32 const sample = poi.firstSample + (offset + i) % SAMPLES_PER_POI;
+        if (player->GetDistance2d(samples[sample].x, samples[sample].y) >= maxDistance)
+            continue;
+
+        if (GetSampleZone(player, sample) != zoneId + 1)
+            continue;
+
+        x = samples[sample].x;
+        y = samples[sample].y;
+        return true;
+    }
+
+    return false;
+}
+
+uint32 QuestPOIIndex::GetSampleZone(Player* player, uint32 sample)
+{
+    uint32 zone = sampleZones[sample].load(std::memory_order_relaxed);
+    if (zone != ZONE_UNRESOLVED)
+        return zone;
+
+    // Same checks the rpg actions made on every pick; racing bots of the same map store the same result
+    Map* map = player->GetMap();
+    float const x = samples[sample].x;
+    float const y = samples[sample].y;
+    float const z = std::max(map->GetHeight(x, y, MAX_HEIGHT), map->GetWaterLevel(x, y));
+
+    if (z == INVALID_HEIGHT || z == VMAP_INVALID_HEIGHT_VALUE)
+        zone = ZONE_INVALID;
+    else
+        zone = map->GetZoneId(player->GetPhaseMask(), x, y, z) + 1;
+
+    sampleZones[sample].store(zone, std::memory_order_relaxed);
+    ++resolved;
+    return zone;
+}
+
+void QuestPOIIndex::PrintStats(ChatHandler* handler) const
+{
+    handler->PSendSysMessage("Quest POI index: {} quests, {} areas, {} samples, {} resolved, {} selects",
+                             questKeys.size(), pois.size(), samples.size(), resolved.load(), selects.load());
+}
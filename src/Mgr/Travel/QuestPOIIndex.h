@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_QUESTPOIINDEX_H
+#define _PLAYERBOT_QUESTPOIINDEX_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Common.h"
+
+class ChatHandler;
+class Player;
+
+struct QuestPOILocation
+{
+    uint32 mapId;
+    int32 objectiveIdx;  // -1 is where the quest is rewarded
+    uint32 firstSample;
+};
+
+// Quest id -> POI areas built once at startup from the quest POI store, stored CSR style like LootIndex. Every area
+// gets SAMPLES_PER_POI random positions inside its points up front. Terrain is not loaded at startup, so the ground
+// height and zone of a sample are resolved by the first bot that looks at it and shared by all bots after that.
+class QuestPOIIndex
+{
+public:
+    static QuestPOIIndex* instance()
+    {
+        static QuestPOIIndex instance;
+        return &instance;
+    }
+
+    void Build();
+    bool IsBuilt() const { return built; }
+
+    QuestPOILocation const* QuestBegin(uint32 questId) const;
+    QuestPOILocation const* QuestEnd(uint32 questId) const;
+
+    // Random sample of the area on the player's map, within maxDistance (2d) and in the player's zone.
+    // Map thread of the player.
+    bool SelectSample(Player* player, QuestPOILocation const& poi, float maxDistance, float& x, float& y);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    QuestPOIIndex() {}
+
+    static uint32 const SAMPLES_PER_POI = 8;
+    static uint32 const ZONE_UNRESOLVED = 0;
+    static uint32 const ZONE_INVALID = 0xFFFFFFFF;  // no ground or water at the sample
+
+    struct Sample
+    {
+        float x;
+        float y;
+    };
+
+    uint32 FindQuest(uint32 questId) const;
+    uint32 GetSampleZone(Player* player, uint32 sample);
+
+    bool built = false;
+
+    std::vector<uint32> questKeys;
+    std::vector<uint32> questOffsets;
+    std::vector<QuestPOILocation> pois;
+    std::vector<Sample> samples;
+    std::unique_ptr<std::atomic<uint32>[]> sampleZones;  // zone id + 1, or ZONE_UNRESOLVED / ZONE_INVALID
+
+    std::atomic<uint64> selects{0};
+    std::atomic<uint64> resolved{0};
+};
+
+#define sQuestPOIIndex QuestPOIIndex::instance()
+
+#endif
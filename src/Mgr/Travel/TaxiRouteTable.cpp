@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "TaxiRouteTable.h"
+
+#include <algorithm>
+
+#include "Chat.h"
+#include "DBCStores.h"
+#include "Log.h"
+#include "Map.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+#include "RandomPlayerbotMgr.h"
+#include "Timer.h"
+
+void TaxiRouteTable::Build()
+{
+    uint32 const oldMSTime = getMSTime();
+    uint32 const nodeCount = sTaxiNodesStore.GetNumRows();
+
+    nodes.assign(nodeCount, {NODE_MISSING, 0.0f, 0.0f, 0.0f});
+    for (uint32 i = 1; i < nodeCount; ++i)
+        if (TaxiNodesEntry const* node = sTaxiNodesStore.LookupEntry(i))
+            nodes[i] = {node->map_id, node->x, node->y, node->z};
+
+    for (uint8 team = 0; team < PVP_TEAMS_COUNT; ++team)
+    {
+        // dk flights have no mount for the team
+        uint8 const mountIndex = team == TEAM_ALLIANCE ? 1 : 0;
+
+        routeOffsets[team].assign(nodeCount + 1, 0);
+        routes[team].clear();
+
+        for (uint32 from = 1; from < nodeCount; ++from)
+        {
+            routeOffsets[team][from] = routes[team].size();
+            if (nodes[from].mapId == NODE_MISSING)
+                continue;
+
+            for (uint32 to = 1; to < nodeCount; ++to)
+            {
+                if (from == to || nodes[to].mapId != nodes[from].mapId)
+                    continue;
+
+                if (!sTaxiNodesStore.LookupEntry(to)->MountCreatureID[mountIndex])
+                    continue;
+
+                uint32 path, cost;
+                sObjectMgr->GetTaxiPath(from, to, path, cost);
+                if (!path)
+                    continue;
+
+                routes[team].push_back({to, cost});
+            }
+        }
+        routeOffsets[team][nodeCount] = routes[team].size();
+
+        routes[team].shrink_to_fit();
+    }
+
+    nodeBands.reset(new std::atomic<uint32>[nodeCount]);
+    for (uint32 i = 0; i < nodeCount; ++i)
+        nodeBands[i].store(0, std::memory_order_relaxed);
+
+    built = true;
+
+    LOG_INFO("playerbots", ">> Taxi route table built: {} nodes, {} alliance and {} horde routes in {} ms", nodeCount,
+             routes[TEAM_ALLIANCE].size(), routes[TEAM_HORDE].size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+TaxiRoute const* TaxiRouteTable::RoutesBegin(TeamId team, uint32 fromNode) const
+{
+    if (team >= PVP_TEAMS_COUNT || fromNode + 1 >= routeOffsets[team].size())
+        return nullptr;
+
+    return routes[team].data() + routeOffsets[team][fromNode];
+}
+
+TaxiRoute const* TaxiRouteTable::RoutesEnd(TeamId team, uint32 fromNode) const
+{
+    if (team >= PVP_TEAMS_COUNT || fromNode + 1 >= routeOffsets[team].size())
+        return nullptr;
+
+    return routes[team].data() + routeOffsets[team][fromNode + 1];
+}
+
+TaxiRouteNode const* TaxiRouteTable::GetNode(uint32 node) const
+{
+    if (node >= nodes.size() || nodes[node].mapId == NODE_MISSING)
+        return nullptr;
+
+    return &nodes[node];
+}
+
+bool TaxiRouteTable::GetLevelBand(Player* player, uint32 node, uint8& low, uint8& high)
+{
+    TaxiRouteNode const* entry = GetNode(node);
+    if (!entry || entry->mapId != player->GetMapId())
+        return false;
+
+    uint32 band = nodeBands[node].load(std::memory_order_relaxed);
+    if (!(band & BAND_RESOLVED))
+    {
+        band = BAND_RESOLVED;
+
+        uint32 const zoneId = player->GetMap()->GetZoneId(player->GetPhaseMask(), entry->x, entry->y, entry->z);
+        AreaTableEntry const* zone = sAreaTableStore.LookupEntry(zoneId);
+        auto itr = sRandomPlayerbotMgr->zone2LevelBracket.find(zoneId);
+        if (zone && (zone->flags & AREA_FLAG_CAPITAL))
+        {
+            band |= BAND_USABLE | 0xFF;
+        }
+        else if (itr != sRandomPlayerbotMgr->zone2LevelBracket.end())
+        {
+            uint32 const lowLevel = std::min<uint32>(itr->second.low, 0xFF);
+            uint32 const highLevel = std::min<uint32>(itr->second.high, 0xFF);
+            band |= BAND_USABLE | (lowLevel << 8) | highLevel;
+        }
+
+        nodeBands[node].store(band, std::memory_order_relaxed);
+        ++resolved;
+    }
+
+    if (!(band & BAND_USABLE))
+        return false;
+
+    low = (band >> 8) & 0xFF;
+    high = band & 0xFF;
+    return true;
+}
+
+void TaxiRouteTable::PrintStats(ChatHandler* handler) const
+{
+    handler->PSendSysMessage("Taxi route table: {} nodes, {} alliance routes, {} horde routes, {} level bands resolved",
+                             nodes.size(), routes[TEAM_ALLIANCE].size(), routes[TEAM_HORDE].size(), resolved.load());
+}
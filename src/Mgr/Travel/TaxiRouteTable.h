@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_TAXIROUTETABLE_H
+#define _PLAYERBOT_TAXIROUTETABLE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Common.h"
+#include "SharedDefines.h"
+
+class ChatHandler;
+class Player;
+
+struct TaxiRoute
+{
+    uint32 toNode;
+    uint32 cost;
+};
+
+struct TaxiRouteNode
+{
+    uint32 mapId;
+    float x;
+    float y;
+    float z;
+};
+
+// Per team, taxi node -> nodes with a direct flight path and its cost, built once at startup from the taxi stores and
+// stored CSR style like LootIndex. Nodes without a mount for the team (death knight flights) are left out. The level
+// band of a node comes from the zone it lies in; terrain is not loaded at startup, so the first bot on the node's map
+// that asks resolves it for all bots.
+class TaxiRouteTable
+{
+public:
+    static TaxiRouteTable* instance()
+    {
+        static TaxiRouteTable instance;
+        return &instance;
+    }
+
+    void Build();
+    bool IsBuilt() const { return built; }
+
+    TaxiRoute const* RoutesBegin(TeamId team, uint32 fromNode) const;
+    TaxiRoute const* RoutesEnd(TeamId team, uint32 fromNode) const;
+    TaxiRouteNode const* GetNode(uint32 node) const;
+
+    // Level range the node's zone is meant for, any level for capitals; false when the zone has none.
+    // Map thread of a player on the node's map.
+    bool GetLevelBand(Player* player, uint32 node, uint8& low, uint8& high);
+
+    void PrintStats(ChatHandler* handler) const;
+
+private:
+    TaxiRouteTable() {}
+
+    static uint32 const BAND_RESOLVED = 0x80000000;
+    static uint32 const BAND_USABLE = 0x40000000;
+    static uint32 const NODE_MISSING = 0xFFFFFFFF;
+
+    bool built = false;
+
+    std::vector<TaxiRouteNode> nodes;  // by node id, mapId is NODE_MISSING for missing nodes
+    std::vector<uint32> routeOffsets[PVP_TEAMS_COUNT];
+    std::vector<TaxiRoute> routes[PVP_TEAMS_COUNT];
+    std::unique_ptr<std::atomic<uint32>[]> nodeBands;  // BAND_* flags, low level << 8 | high level
+
+    std::atomic<uint64> resolved{0};
+};
+
+#define sTaxiRouteTable TaxiRouteTable::instance()
+
+#endif
@@ -13,6 +13,7 @@
 #include "Playerbots.h"
 #include "ServerFacade.h"
 #include "TransportMgr.h"
+#include "TravelNodeSnapshot.h"
 
 // TravelNodePath(float distance = 0.1f, float extraCost = 0, TravelNodePathType pathType = TravelNodePathType::walk,
 // uint32 pathObject = 0, bool calculated = false, std::vector<uint8> maxLevelCreature = { 0,0,0 }, float swimDistance =
@@ -2346,6 +2347,9 @@ void TravelNodeMap::saveNodeStore()
 
     LOG_INFO("playerbots", ">> Saved {} travelNodes.", anodes.size());
 
+    TravelNodeSnapshotSource source;
+    source.nodes = anodes.size();
+
     {
         uint32 paths = 0, points = 0;
         for (uint32 i = 0; i < anodes.size(); i++)
@@ -2396,14 +2400,50 @@ void TravelNodeMap::saveNodeStore()
         }
 
         LOG_INFO("playerbots", ">> Saved {} travelNode Paths, {} points.", paths, points);
+
+        source.links = paths;
+        source.points = points;
     }
 
     PlayerbotsDatabase.CommitTransaction(trans);
+
+    std::string const snapshotPath = TravelNodeSnapshot::GetConfiguredPath();
+    if (!snapshotPath.empty())
+        TravelNodeSnapshot::Write(snapshotPath, anodes, source);
 }
 
 void TravelNodeMap::loadNodeStore()
 {
-    std::string const query = "SELECT id, name, map_id, x, y, z, linked FROM playerbots_travelnode";
+    std::string const snapshotPath = TravelNodeSnapshot::GetConfiguredPath();
+    uint32 const loadStart = getMSTime();
+
+    if (!snapshotPath.empty())
+    {
+        TravelNodeSnapshot snapshot;
+        if (snapshot.Map(snapshotPath))
+        {
+            if (snapshot.GetSource() == TravelNodeSnapshotSource::Query())
+            {
+                loadNodeSnapshot(snapshot);
+                LOG_INFO("playerbots", ">> Loaded travelNode graph from {} in {} ms", snapshotPath,
+                         GetMSTimeDiffToNow(loadStart));
+                return;
+            }
+
+            LOG_INFO("playerbots", "Travel node snapshot {} does not match the database, rebuilding it", snapshotPath);
+        }
+    }
+
+    TravelNodeSnapshotSource const source = loadNodeStoreFromDatabase();
+    LOG_INFO("playerbots", ">> Loaded travelNode graph from the database in {} ms", GetMSTimeDiffToNow(loadStart));
+
+    if (!snapshotPath.empty() && source.nodes)
+        TravelNodeSnapshot::Write(snapshotPath, m_nodes, source);
+}
+
+TravelNodeSnapshotSource TravelNodeMap::loadNodeStoreFromDatabase()
+{
+    TravelNodeSnapshotSource source;
 
     std::unordered_map<uint32, TravelNode*> saveNodes;
 
@@ -2428,6 +2468,7 @@ void TravelNodeMap::loadNodeStore()
 
             } while (result->NextRow());
 
+            source.nodes = result->GetRowCount();
             LOG_INFO("playerbots", ">> Loaded {} travelNodes.", saveNodes.size());
         }
         else
@@ -2464,6 +2505,7 @@ void TravelNodeMap::loadNodeStore()
 
             } while (result->NextRow());
 
+            source.links = result->GetRowCount();
             LOG_INFO("playerbots", ">> Loaded {} travelNode paths.", result->GetRowCount());
         }
         else
@@ -2499,6 +2541,7 @@ void TravelNodeMap::loadNodeStore()
 
             } while (result->NextRow());
 
+            source.points = result->GetRowCount();
             LOG_INFO("playerbots", ">> Loaded {} travelNode paths points.", result->GetRowCount());
         }
         else
@@ -2506,6 +2549,75 @@ void TravelNodeMap::loadNodeStore()
             LOG_ERROR("playerbots", ">> Error loading travelNode paths.");
         }
     }
+
+    return source;
+}
+
+void TravelNodeMap::loadNodeSnapshot(TravelNodeSnapshot const& snapshot)
+{
+    if (!snapshot.GetNodeCount())
+    {
+        hasToFullGen = true;
+        LOG_ERROR("playerbots", ">> Error loading travelNodes.");
+        return;
+    }
+
+    // Same graph as loadNodeStoreFromDatabase builds, the snapshot index replaces the node id
+    std::vector<TravelNode*> snapshotNodes;
+    snapshotNodes.reserve(snapshot.GetNodeCount());
+
+    for (uint32 i = 0; i < snapshot.GetNodeCount(); ++i)
+    {
+        TravelNodeSnapshotNode const& node = snapshot.GetNode(i);
+
+        TravelNode* travelNode =
+            addNode(WorldPosition(node.mapId, node.x, node.y, node.z), snapshot.GetName(node), true);
+
+        if (node.linked)
+            travelNode->setLinked(true);
+        else
+            hasToGen = true;
+
+        snapshotNodes.push_back(travelNode);
+    }
+
+    LOG_INFO("playerbots", ">> Loaded {} travelNodes.", snapshotNodes.size());
+
+    for (uint32 i = 0; i < snapshot.GetNodeCount(); ++i)
+    {
+        TravelNode* startNode = snapshotNodes[i];
+
+        for (TravelNodeSnapshotLink const* link = snapshot.GetLinksBegin(i); link != snapshot.GetLinksEnd(i); ++link)
+        {
+            TravelNodePath* path = startNode->setPathTo(
+                snapshotNodes[link->endNode],
+                TravelNodePath(link->distance, link->extraCost, link->pathType, link->pathObject, link->calculated,
+                               {link->maxLevelCreature[0], link->maxLevelCreature[1], link->maxLevelCreature[2]},
+                               link->swimDistance),
+                true);
+
+            if (!link->calculated)
+                hasToGen = true;
+
+            if (!path || !link->pointCount)
+                continue;
+
+            std::vector<WorldPosition> ppath;
+            ppath.reserve(link->pointCount);
+
+            TravelNodeSnapshotPoint const* points = snapshot.GetPoints(*link);
+            for (uint32 j = 0; j < link->pointCount; ++j)
+                ppath.push_back(WorldPosition(points[j].mapId, points[j].x, points[j].y, points[j].z));
+
+            path->setPath(ppath);
+
+            if (path->getCalculated())
+                path->setComplete(true);
+        }
+    }
+
+    LOG_INFO("playerbots", ">> Loaded {} travelNode paths, {} points.", snapshot.GetLinkCount(),
+             snapshot.GetPointCount());
 }
 
 void TravelNodeMap::calcMapOffset()
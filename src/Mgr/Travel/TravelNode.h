@@ -10,6 +10,9 @@
 
 #include "TravelMgr.h"
 
+class TravelNodeSnapshot;
+struct TravelNodeSnapshotSource;
+
 // THEORY
 //
 //  Pathfinding in (c)mangos is based on detour recast an opensource nashmesh creation and pathfinding codebase.
@@ -574,6 +577,8 @@ public:
     void printNodeStore();
     void saveNodeStore();
     void loadNodeStore();
+    TravelNodeSnapshotSource loadNodeStoreFromDatabase();
+    void loadNodeSnapshot(TravelNodeSnapshot const& snapshot);
 
     bool cropUselessNode(TravelNode* startNode);
     TravelNode* addZoneLinkNode(TravelNode* startNode);
@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "TravelNodeSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+#include "Chat.h"
+#include "Log.h"
+#include "Playerbots.h"
+#include "Timer.h"
+#include "TravelNode.h"
+#include "World.h"
+
+static char const SNAPSHOT_MAGIC[4] = {'P', 'B', 'T', 'N'};
+
+TravelNodeSnapshotSource TravelNodeSnapshotSource::Query()
+{
+    TravelNodeSnapshotSource source;
+
+    // COUNT(*) is kept by MyISAM, this does not scan the tables
+    if (QueryResult result = PlayerbotsDatabase.Query(
+            "SELECT (SELECT COUNT(*) FROM playerbots_travelnode), (SELECT COUNT(*) FROM playerbots_travelnode_link), "
+            "(SELECT COUNT(*) FROM playerbots_travelnode_path)"))
+    {
+        Field* fields = result->Fetch();
+        source.nodes = uint32(fields[0].Get<uint64>());
+        source.links = uint32(fields[1].Get<uint64>());
+        source.points = uint32(fields[2].Get<uint64>());
+    }
+
+    return source;
+}
+
+TravelNodeSnapshot::TravelNodeSnapshot() {}
+
+TravelNodeSnapshot::~TravelNodeSnapshot() { Unmap(); }
+
+uint64 TravelNodeSnapshot::Checksum(char const* data, uint64 length, uint64 hash)
+{
+    for (uint64 i = 0; i < length; ++i)
+        hash = (hash ^ uint8(data[i])) * 1099511628211ull;
+
+    return hash;
+}
+
+bool TravelNodeSnapshot::Map(std::string const path)
+{
+    Unmap();
+
+    try
+    {
+        file = std::make_unique<boost::interprocess::file_mapping>(path.c_str(), boost::interprocess::read_only);
+        region = std::make_unique<boost::interprocess::mapped_region>(*file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        LOG_DEBUG("playerbots", "Travel node snapshot {} not mapped: {}", path, e.what());
+        Unmap();
+        return false;
+    }
+
+    char const* data = static_cast<char const*>(region->get_address());
+    size = region->get_size();
+
+    auto reject = [&](char const* reason)
+    {
+        LOG_ERROR("playerbots", "Travel node snapshot {} is {}, ignoring it", path, reason);
+        Unmap();
+        return false;
+    };
+
+    if (size < sizeof(TravelNodeSnapshotHeader))
+        return reject("truncated");
+
+    header = reinterpret_cast<TravelNodeSnapshotHeader const*>(data);
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)))
+        return reject("not a travel node snapshot");
+
+    if (header->version != VERSION)
+        return reject("of another version");
+
+    uint64 offset = sizeof(TravelNodeSnapshotHeader);
+    uint64 const nodesOffset = offset;
+    offset += uint64(header->nodeCount) * sizeof(TravelNodeSnapshotNode);
+    uint64 const linkOffsetsOffset = offset;
+    offset += (uint64(header->nodeCount) + 1) * sizeof(uint32);
+    uint64 const linksOffset = offset;
+    offset += uint64(header->linkCount) * sizeof(TravelNodeSnapshotLink);
+    uint64 const pointsOffset = offset;
+    offset += uint64(header->pointCount) * sizeof(TravelNodeSnapshotPoint);
+    uint64 const namesOffset = offset;
+    offset += header->nameBytes;
+
+    if (offset != size)
+        return reject("truncated");
+
+    if (Checksum(data + sizeof(TravelNodeSnapshotHeader), size - sizeof(TravelNodeSnapshotHeader)) != header->checksum)
+        return reject("corrupt");
+
+    nodes = reinterpret_cast<TravelNodeSnapshotNode const*>(data + nodesOffset);
+    linkOffsets = reinterpret_cast<uint32 const*>(data + linkOffsetsOffset);
+    links = reinterpret_cast<TravelNodeSnapshotLink const*>(data + linksOffset);
+    points = reinterpret_cast<TravelNodeSnapshotPoint const*>(data + pointsOffset);
+    names = data + namesOffset;
+
+    // Indices are trusted by the loader, check them once here
+    if (linkOffsets[0] != 0 || linkOffsets[header->nodeCount] != header->linkCount)
+        return reject("inconsistent");
+
+    for (uint32 i = 0; i < header->nodeCount; ++i)
+    {
+        if (linkOffsets[i] > linkOffsets[i + 1] ||
+            uint64(nodes[i].nameOffset) + nodes[i].nameLength > header->nameBytes)
+            return reject("inconsistent");
+    }
+
+    for (uint32 i = 0; i < header->linkCount; ++i)
+    {
+        if (links[i].endNode >= header->nodeCount ||
+            uint64(links[i].pointOffset) + links[i].pointCount > header->pointCount)
+            return reject("inconsistent");
+    }
+
+    return true;
+}
+
+void TravelNodeSnapshot::Unmap()
+{
+    region.reset();
+    file.reset();
+    size = 0;
+    header = nullptr;
+    nodes = nullptr;
+    linkOffsets = nullptr;
+    links = nullptr;
+    points = nullptr;
+    names = nullptr;
+}
+
+TravelNodeSnapshotSource TravelNodeSnapshot::GetSource() const
+{
+    TravelNodeSnapshotSource source;
+    if (header)
+    {
+        source.nodes = header->sourceNodes;
+        source.links = header->sourceLinks;
+        source.points = header->sourcePoints;
+    }
+
+    return source;
+}
+
+std::string const TravelNodeSnapshot::GetName(TravelNodeSnapshotNode const& node) const
+{
+    return std::string(names + node.nameOffset, node.nameLength);
+}
+
+void TravelNodeSnapshot::Builder::AddNode(uint32 mapId, float x, float y, float z, std::string const& name, bool linked)
+{
+    TravelNodeSnapshotNode node;
+    memset(&node, 0, sizeof(node));
+    node.mapId = mapId;
+    node.x = x;
+    node.y = y;
+    node.z = z;
+    node.nameOffset = names.size();
+    node.nameLength = name.size();
+    node.linked = linked;
+    nodes.push_back(node);
+
+    names += name;
+}
+
+bool TravelNodeSnapshot::Builder::Write(std::string const path, TravelNodeSnapshotSource source)
+{
+    if (linkOffsets.size() != nodes.size() + 1)
+        return false;
+
+    TravelNodeSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = VERSION;
+    header.nodeCount = nodes.size();
+    header.linkCount = links.size();
+    header.pointCount = points.size();
+    header.nameBytes = names.size();
+    header.sourceNodes = source.nodes;
+    header.sourceLinks = source.links;
+    header.sourcePoints = source.points;
+
+    std::vector<std::pair<char const*, uint64>> const sections = {
+        {reinterpret_cast<char const*>(nodes.data()), nodes.size() * sizeof(TravelNodeSnapshotNode)},
+        {reinterpret_cast<char const*>(linkOffsets.data()), linkOffsets.size() * sizeof(uint32)},
+        {reinterpret_cast<char const*>(links.data()), links.size() * sizeof(TravelNodeSnapshotLink)},
+        {reinterpret_cast<char const*>(points.data()), points.size() * sizeof(TravelNodeSnapshotPoint)},
+        {names.data(), names.size()}};
+
+    header.checksum = 14695981039346656037ull;
+    for (auto const& section : sections)
+        header.checksum = Checksum(section.first, section.second, header.checksum);
+
+    // Write next to the old file and swap, a running server may have the old one mapped
+    std::string const tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            LOG_ERROR("playerbots", "Cannot write travel node snapshot {}", tmpPath);
+            return false;
+        }
+
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        for (auto const& section : sections)
+            out.write(section.first, section.second);
+
+        if (!out)
+        {
+            LOG_ERROR("playerbots", "Cannot write travel node snapshot {}", tmpPath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmpPath, path, error);
+    if (error)
+    {
+        LOG_ERROR("playerbots", "Cannot replace travel node snapshot {}: {}", path, error.message());
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    LOG_INFO("playerbots", ">> Wrote travel node snapshot {}: {} nodes, {} paths, {} points, {} KB", path,
+             nodes.size(), links.size(), points.size(),
+             (sizeof(header) + sections[0].second + sections[1].second + sections[2].second + sections[3].second +
+              sections[4].second) / 1024);
+    return true;
+}
+
+bool TravelNodeSnapshot::Write(std::string const path, std::vector<TravelNode*> const& graph,
+                               TravelNodeSnapshotSource source)
+{
+    Builder builder;
+
+    std::unordered_map<TravelNode*, uint32> index;
+    for (TravelNode* node : graph)
+    {
+        // Same name as saveNodeStore writes to playerbots_travelnode
+        std::string name = node->getName();
+        name.erase(std::remove(name.begin(), name.end(), '\''), name.end());
+
+        index[node] = builder.nodes.size();
+        builder.AddNode(node->getMapId(), node->getX(), node->getY(), node->getZ(), name, node->isLinked());
+    }
+
+    for (TravelNode* node : graph)
+    {
+        builder.linkOffsets.push_back(builder.links.size());
+
+        for (auto& link : *node->getLinks())
+        {
+            std::unordered_map<TravelNode*, uint32>::const_iterator end = index.find(link.first);
+            if (end == index.end())
+                continue;
+
+            TravelNodePath* path = link.second;
+            std::vector<uint8> const maxLevelCreature = path->getMaxLevelCreature();
+
+            TravelNodeSnapshotLink snapshotLink;
+            memset(&snapshotLink, 0, sizeof(snapshotLink));
+            snapshotLink.endNode = end->second;
+            snapshotLink.pathObject = path->getPathObject();
+            snapshotLink.distance = path->getDistance();
+            snapshotLink.swimDistance = path->getSwimDistance();
+            snapshotLink.extraCost = path->getExtraCost();
+            snapshotLink.pathType = uint8(path->getPathType());
+            snapshotLink.calculated = path->getCalculated();
+            for (uint8 i = 0; i < 3 && i < maxLevelCreature.size(); ++i)
+                snapshotLink.maxLevelCreature[i] = maxLevelCreature[i];
+
+            snapshotLink.pointOffset = builder.points.size();
+            for (WorldPosition& point : path->getPath())
+                builder.points.push_back({point.getMapId(), point.getX(), point.getY(), point.getZ()});
+            snapshotLink.pointCount = builder.points.size() - snapshotLink.pointOffset;
+
+            builder.links.push_back(snapshotLink);
+        }
+    }
+
+    builder.linkOffsets.push_back(builder.links.size());
+
+    return builder.Write(path, source);
+}
+
+bool TravelNodeSnapshot::WriteFromDatabase(std::string const path)
+{
+    Builder builder;
+    TravelNodeSnapshotSource source;
+
+    std::unordered_map<uint32, uint32> index;  // node id -> snapshot index
+    if (QueryResult result =
+            PlayerbotsDatabase.Query("SELECT id, name, map_id, x, y, z, linked FROM playerbots_travelnode ORDER BY id"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            index[fields[0].Get<uint32>()] = builder.nodes.size();
+            builder.AddNode(fields[2].Get<uint32>(), fields[3].Get<float>(), fields[4].Get<float>(),
+                            fields[5].Get<float>(), fields[1].Get<std::string>(), fields[6].Get<bool>());
+            ++source.nodes;
+        } while (result->NextRow());
+    }
+    else
+    {
+        LOG_ERROR("playerbots", "No travel nodes in playerbots_travelnode, no snapshot written");
+        return false;
+    }
+
+    typedef std::pair<uint32, uint32> NodePair;  // start index, end index
+    std::map<NodePair, std::vector<TravelNodeSnapshotPoint>> paths;
+    if (QueryResult result = PlayerbotsDatabase.Query(
+            "SELECT node_id, to_node_id, map_id, x, y, z FROM playerbots_travelnode_path "
+            "ORDER BY node_id, to_node_id, nr"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            ++source.points;
+
+            std::unordered_map<uint32, uint32>::const_iterator start = index.find(fields[0].Get<uint32>());
+            std::unordered_map<uint32, uint32>::const_iterator end = index.find(fields[1].Get<uint32>());
+            if (start == index.end() || end == index.end())
+                continue;
+
+            paths[NodePair(start->second, end->second)].push_back(
+                {fields[2].Get<uint32>(), fields[3].Get<float>(), fields[4].Get<float>(), fields[5].Get<float>()});
+        } while (result->NextRow());
+    }
+
+    std::vector<std::vector<TravelNodeSnapshotLink>> nodeLinks(builder.nodes.size());
+    if (QueryResult result = PlayerbotsDatabase.Query(
+            "SELECT node_id, to_node_id, type, object, distance, swim_distance, extra_cost, calculated, "
+            "max_creature_0, max_creature_1, max_creature_2 FROM playerbots_travelnode_link"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            ++source.links;
+
+            std::unordered_map<uint32, uint32>::const_iterator start = index.find(fields[0].Get<uint32>());
+            std::unordered_map<uint32, uint32>::const_iterator end = index.find(fields[1].Get<uint32>());
+            if (start == index.end() || end == index.end())
+                continue;
+
+            TravelNodeSnapshotLink link;
+            memset(&link, 0, sizeof(link));
+            link.endNode = end->second;
+            link.pathType = fields[2].Get<uint8>();
+            link.pathObject = fields[3].Get<uint32>();
+            link.distance = fields[4].Get<float>();
+            link.swimDistance = fields[5].Get<float>();
+            link.extraCost = fields[6].Get<float>();
+            link.calculated = fields[7].Get<bool>();
+            link.maxLevelCreature[0] = fields[8].Get<uint8>();
+            link.maxLevelCreature[1] = fields[9].Get<uint8>();
+            link.maxLevelCreature[2] = fields[10].Get<uint8>();
+            nodeLinks[start->second].push_back(link);
+        } while (result->NextRow());
+    }
+
+    for (uint32 i = 0; i < nodeLinks.size(); ++i)
+    {
+        builder.linkOffsets.push_back(builder.links.size());
+
+        for (TravelNodeSnapshotLink& link : nodeLinks[i])
+        {
+            link.pointOffset = builder.points.size();
+
+            auto itr = paths.find(NodePair(i, link.endNode));
+            if (itr != paths.end())
+                builder.points.insert(builder.points.end(), itr->second.begin(), itr->second.end());
+
+            link.pointCount = builder.points.size() - link.pointOffset;
+            builder.links.push_back(link);
+        }
+    }
+
+    builder.linkOffsets.push_back(builder.links.size());
+
+    return builder.Write(path, source);
+}
+
+std::string const TravelNodeSnapshot::GetConfiguredPath()
+{
+    std::string path = sPlayerbotAIConfig->travelNodeSnapshot;
+    if (path.empty() || std::filesystem::path(path).is_absolute())
+        return path;
+
+    return sWorld->GetDataPath() + path;
+}
+
+void TravelNodeSnapshot::PrintStats(ChatHandler* handler)
+{
+    std::string const path = GetConfiguredPath();
+    if (path.empty())
+    {
+        handler->PSendSysMessage("Travel node snapshot is disabled (AiPlayerbot.TravelNodeSnapshot)");
+        return;
+    }
+
+    uint32 const mapStart = getMSTime();
+    TravelNodeSnapshot snapshot;
+    bool const mapped = snapshot.Map(path);
+    uint32 const mapTime = GetMSTimeDiffToNow(mapStart);
+
+    // Same queries as TravelNodeMap::loadNodeStore, result rows are only fetched, not turned into nodes
+    uint32 const sqlStart = getMSTime();
+    uint64 rows = 0;
+    uint64 fields = 0;
+    for (char const* query : {"SELECT id, name, map_id, x, y, z, linked FROM playerbots_travelnode",
+                              "SELECT node_id, to_node_id, type, object, distance, swim_distance, extra_cost, "
+                              "calculated, max_creature_0, max_creature_1, max_creature_2 FROM "
+                              "playerbots_travelnode_link",
+                              "SELECT node_id, to_node_id, nr, map_id, x, y, z FROM playerbots_travelnode_path"})
+    {
+        if (QueryResult result = PlayerbotsDatabase.Query(query))
+        {
+            rows += result->GetRowCount();
+            fields += result->GetRowCount() * result->GetFieldCount();
+        }
+    }
+    uint32 const sqlTime = GetMSTimeDiffToNow(sqlStart);
+
+    if (mapped)
+        handler->PSendSysMessage("Snapshot {}: {} nodes, {} paths, {} points, {} KB mapped and verified in {} ms",
+                                 path, snapshot.GetNodeCount(), snapshot.GetLinkCount(), snapshot.GetPointCount(),
+                                 snapshot.GetSize() / 1024, mapTime);
+    else
+        handler->PSendSysMessage("Snapshot {} is missing or invalid", path);
+
+    handler->PSendSysMessage("Tables: {} rows read in {} ms, ~{} KB of result fields held while loading", rows,
+                             sqlTime, fields * sizeof(Field) / 1024);
+    handler->PSendSysMessage("Both build the same node graph, the snapshot pages are unmapped after loading");
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_TRAVELNODESNAPSHOT_H
+#define _PLAYERBOT_TRAVELNODESNAPSHOT_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+class ChatHandler;
+class TravelNode;
+
+// Row counts of playerbots_travelnode, playerbots_travelnode_link and playerbots_travelnode_path. A snapshot
+// whose counts differ from the tables (e.g. after a module update added nodes) is rebuilt.
+struct TravelNodeSnapshotSource
+{
+    uint32 nodes = 0;
+    uint32 links = 0;
+    uint32 points = 0;
+
+    bool operator==(TravelNodeSnapshotSource const& other) const
+    {
+        return nodes == other.nodes && links == other.links && points == other.points;
+    }
+
+    static TravelNodeSnapshotSource Query();
+};
+
+// Binary copy of the playerbots_travelnode, playerbots_travelnode_link and playerbots_travelnode_path tables.
+// Layout: header, nodes, link offsets (nodes + 1, CSR), links, path points, names. All records are 4 byte aligned
+// and written in host byte order, the file is a local cache and is rebuilt when the version does not match.
+struct TravelNodeSnapshotHeader
+{
+    char magic[4];
+    uint32 version;
+    uint32 nodeCount;
+    uint32 linkCount;
+    uint32 pointCount;
+    uint32 nameBytes;
+    uint32 sourceNodes;
+    uint32 sourceLinks;
+    uint32 sourcePoints;
+    uint32 padding;
+    uint64 checksum;  // FNV-1a of everything after the header
+};
+
+struct TravelNodeSnapshotNode
+{
+    uint32 mapId;
+    float x, y, z;
+    uint32 nameOffset;
+    uint32 nameLength;
+    uint32 linked;
+    uint32 padding;
+};
+
+struct TravelNodeSnapshotLink
+{
+    uint32 endNode;  // index into the nodes
+    uint32 pathObject;
+    float distance;
+    float swimDistance;
+    float extraCost;
+    uint32 pointOffset;
+    uint32 pointCount;
+    uint8 pathType;
+    uint8 calculated;
+    uint8 maxLevelCreature[3];
+    uint8 padding[3];
+};
+
+struct TravelNodeSnapshotPoint
+{
+    uint32 mapId;
+    float x, y, z;
+};
+
+class TravelNodeSnapshot
+{
+public:
+    static uint32 const VERSION = 1;
+
+    TravelNodeSnapshot();
+    ~TravelNodeSnapshot();
+
+    // Maps the file read-only and checks version, sizes and checksum
+    bool Map(std::string const path);
+    void Unmap();
+
+    uint32 GetNodeCount() const { return header ? header->nodeCount : 0; }
+    uint32 GetLinkCount() const { return header ? header->linkCount : 0; }
+    uint32 GetPointCount() const { return header ? header->pointCount : 0; }
+    uint64 GetSize() const { return size; }
+    TravelNodeSnapshotSource GetSource() const;
+
+    TravelNodeSnapshotNode const& GetNode(uint32 index) const { return nodes[index]; }
+    std::string const GetName(TravelNodeSnapshotNode const& node) const;
+    TravelNodeSnapshotLink const* GetLinksBegin(uint32 index) const { return links + linkOffsets[index]; }
+    TravelNodeSnapshotLink const* GetLinksEnd(uint32 index) const { return links + linkOffsets[index + 1]; }
+    TravelNodeSnapshotPoint const* GetPoints(TravelNodeSnapshotLink const& link) const
+    {
+        return points + link.pointOffset;
+    }
+
+    // Writes a snapshot of the in-memory graph, as saved by TravelNodeMap::saveNodeStore
+    static bool Write(std::string const path, std::vector<TravelNode*> const& graph, TravelNodeSnapshotSource source);
+    // Writes a snapshot straight from the playerbots_travelnode* tables, without touching the loaded graph
+    static bool WriteFromDatabase(std::string const path);
+
+    // Full path of the configured snapshot (AiPlayerbot.TravelNodeSnapshot), empty when disabled
+    static std::string const GetConfiguredPath();
+    // Times mapping the snapshot against reading the tables, the loaded graph is not touched
+    static void PrintStats(ChatHandler* handler);
+
+private:
+    struct Builder
+    {
+        std::vector<TravelNodeSnapshotNode> nodes;
+        std::vector<uint32> linkOffsets;
+        std::vector<TravelNodeSnapshotLink> links;
+        std::vector<TravelNodeSnapshotPoint> points;
+        std::string names;
+
+        void AddNode(uint32 mapId, float x, float y, float z, std::string const& name, bool linked);
+        bool Write(std::string const path, TravelNodeSnapshotSource source);
+    };
+
+    static uint64 Checksum(char const* data, uint64 length, uint64 hash = 14695981039346656037ull);
+
+    std::unique_ptr<boost::interprocess::file_mapping> file;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    uint64 size = 0;
+
+    TravelNodeSnapshotHeader const* header = nullptr;
+    TravelNodeSnapshotNode const* nodes = nullptr;
+    uint32 const* linkOffsets = nullptr;
+    TravelNodeSnapshotLink const* links = nullptr;
+    TravelNodeSnapshotPoint const* points = nullptr;
+    char const* names = nullptr;
+};
+
+#endif
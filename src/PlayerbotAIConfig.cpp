@@ -5,16 +5,25 @@
 
 #include "PlayerbotAIConfig.h"
 #include <iostream>
+#include "BattleGroundTactics.h"
 #include "Config.h"
+#include "LootIndex.h"
 #include "NewRpgInfo.h"
+#include "PlayerbotActivityGovernor.h"
 #include "PlayerbotDungeonRepository.h"
 #include "PlayerbotFactory.h"
 #include "Playerbots.h"
 #include "PlayerbotGuildMgr.h"
+#include "PlayerbotSpellRepository.h"
+#include "QuestPOIIndex.h"
 #include "RandomItemMgr.h"
 #include "RandomPlayerbotFactory.h"
 #include "RandomPlayerbotMgr.h"
+#include "ReagentSpellIndex.h"
+#include "StartupTaskGraph.h"
 #include "Talentspec.h"
+#include "TargetValue.h"
+#include "TaxiRouteTable.h"
 
 template <class T>
 void LoadList(std::string const value, T& list)
@@ -134,6 +143,26 @@ bool PlayerbotAIConfig::Initialize()
     allowAccountBots = sConfigMgr->GetOption<bool>("AiPlayerbot.AllowAccountBots", true);
     allowGuildBots = sConfigMgr->GetOption<bool>("AiPlayerbot.AllowGuildBots", true);
     allowTrustedAccountBots = sConfigMgr->GetOption<bool>("AiPlayerbot.AllowTrustedAccountBots", true);
+    startupThreads = sConfigMgr->GetOption<int32>("AiPlayerbot.StartupThreads", 4);
+
+    valueCacheCapacities.clear();
+    std::vector<std::string> valueCaches;
+    LoadListString<std::vector<std::string>>(sConfigMgr->GetOption<std::string>("AiPlayerbot.ValueCacheCapacity", ""),
+                                             valueCaches);
+    for (std::string const& valueCache : valueCaches)
+    {
+        std::string::size_type const separator = valueCache.rfind(':');
+        if (separator == std::string::npos || !separator)
+        {
+            LOG_ERROR("playerbots", "AiPlayerbot.ValueCacheCapacity: {} is not in family:capacity form", valueCache);
+            continue;
+        }
+
+        valueCacheCapacities[valueCache.substr(0, separator)] = atoi(valueCache.substr(separator + 1).c_str());
+    }
+
+    travelNodeSnapshot = sConfigMgr->GetOption<std::string>("AiPlayerbot.TravelNodeSnapshot", "");
+
     disabledWithoutRealPlayer = sConfigMgr->GetOption<bool>("AiPlayerbot.DisabledWithoutRealPlayer", false);
     randomBotGuildNearby = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotGuildNearby", false);
     randomBotInvitePlayer = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotInvitePlayer", false);
@@ -204,6 +233,8 @@ bool PlayerbotAIConfig::Initialize()
         sConfigMgr->GetOption<int32>("AiPlayerbot.PermanentlyInWorldTime", 1 * YEAR);
     randomBotTeleportDistance = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotTeleportDistance", 100);
     randomBotsPerInterval = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotsPerInterval", 60);
+    randomBotLoginMaxDiff = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotLoginMaxDiff", 100);
+    repositoryFlushInterval = sConfigMgr->GetOption<int32>("AiPlayerbot.RepositoryFlushInterval", 1000);
     minRandomBotsPriceChangeInterval =
         sConfigMgr->GetOption<int32>("AiPlayerbot.MinRandomBotsPriceChangeInterval", 2 * HOUR);
     maxRandomBotsPriceChangeInterval =
@@ -234,6 +265,8 @@ bool PlayerbotAIConfig::Initialize()
     randomBotEmote = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotEmote", false);
     randomBotSuggestDungeons = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotSuggestDungeons", true);
     randomBotSayWithoutMaster = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotSayWithoutMaster", false);
+    channelCommandMaxBots = sConfigMgr->GetOption<uint32>("AiPlayerbot.ChannelCommandMaxBots", 25);
+    channelBotIndexRefreshInterval = sConfigMgr->GetOption<uint32>("AiPlayerbot.ChannelBotIndexRefreshInterval", 5000);
 
     // broadcastChanceMaxValue is used in urand(1, broadcastChanceMaxValue) for broadcasts,
     // lowering it will increase the chance, setting it to 0 will disable broadcasts
@@ -597,6 +630,16 @@ bool PlayerbotAIConfig::Initialize()
     botActiveAloneSmartScaleDiffLimitCeiling = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleDiffLimitCeiling", 200);
     botActiveAloneSmartScaleWhenMinLevel = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleWhenMinLevel", 1);
     botActiveAloneSmartScaleWhenMaxLevel = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleWhenMaxLevel", 80);
+    activityGovernorEnabled = sConfigMgr->GetOption<bool>("AiPlayerbot.ActivityGovernor.Enable", false);
+    activityGovernorTargetDiff = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.TargetDiff", 100);
+    activityGovernorInterval = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.Interval", 1000);
+    activityGovernorKp = sConfigMgr->GetOption<float>("AiPlayerbot.ActivityGovernor.Kp", 0.3f);
+    activityGovernorKi = sConfigMgr->GetOption<float>("AiPlayerbot.ActivityGovernor.Ki", 0.05f);
+    activityGovernorKd = sConfigMgr->GetOption<float>("AiPlayerbot.ActivityGovernor.Kd", 0.0f);
+    activityGovernorReducedBand = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.ReducedBand", 25);
+    activityGovernorReducedTickInterval = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.ReducedTickInterval", 1000);
+    activityGovernorDormantTickInterval = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.DormantTickInterval", 10000);
+    activityGovernorMetricsInterval = sConfigMgr->GetOption<uint32>("AiPlayerbot.ActivityGovernor.MetricsInterval", 60);
 
     randombotsWalkingRPG = sConfigMgr->GetOption<bool>("AiPlayerbot.RandombotsWalkingRPG", false);
     randombotsWalkingRPGInDoors = sConfigMgr->GetOption<bool>("AiPlayerbot.RandombotsWalkingRPG.InDoors", false);
@@ -617,6 +660,7 @@ bool PlayerbotAIConfig::Initialize()
     autoEquipUpgradeLoot = sConfigMgr->GetOption<bool>("AiPlayerbot.AutoEquipUpgradeLoot", true);
     equipUpgradeThreshold = sConfigMgr->GetOption<float>("AiPlayerbot.EquipUpgradeThreshold", 1.1f);
     twoRoundsGearInit = sConfigMgr->GetOption<bool>("AiPlayerbot.TwoRoundsGearInit", false);
+    randomizePlanThreads = sConfigMgr->GetOption<uint32>("AiPlayerbot.RandomizePlanThreads", 2);
     syncQuestWithPlayer = sConfigMgr->GetOption<bool>("AiPlayerbot.SyncQuestWithPlayer", true);
     syncQuestForPlayer = sConfigMgr->GetOption<bool>("AiPlayerbot.SyncQuestForPlayer", false);
     dropObsoleteQuests = sConfigMgr->GetOption<bool>("AiPlayerbot.DropObsoleteQuests", true);
@@ -662,25 +706,47 @@ bool PlayerbotAIConfig::Initialize()
     // Assign account types after accounts are created
     sRandomPlayerbotMgr->AssignAccountTypes();
 
+    // Creates and deletes guilds through the core guild manager, keep it on this thread
+    sPlayerbotGuildMgr->Init();
+
+    StartupTaskGraph startup;
+
     if (sPlayerbotAIConfig->enabled)
     {
-        sRandomPlayerbotMgr->Init();
+        startup.Add("random bot caches", []() { sRandomPlayerbotMgr->Init(); });
     }
 
-    sPlayerbotGuildMgr->Init();
-    sRandomItemMgr->Init();
-    sRandomItemMgr->InitAfterAhBot();
-    sPlayerbotTextMgr->LoadBotTexts();
-    sPlayerbotTextMgr->LoadBotTextChance();
-    PlayerbotFactory::Init();
+    // Indexes over the static game data, which bots read without locks; a reload would rebuild them under the map
+    // threads, so they are only built by the first Initialize
+    if (!indexesBuilt)
+    {
+        startup.Add("loot index", []() { sLootIndex->Build(); });
+        startup.Add("reagent spell index", []() { sReagentSpellIndex->Build(); });
+        startup.Add("quest poi index", []() { sQuestPOIIndex->Build(); });
+        startup.Add("taxi route table", []() { sTaxiRouteTable->Build(); });
+        startup.Add("creature name index", []() { FindTargetValue::BuildNameIndex(); });
+        startup.Add("bg waypoint graphs", []() { BattleBotWaypointGraph::BuildAll(); });
+        startup.Add("spell repository", []() { sPlayerbotSpellRepository->Initialize(); });
+    }
 
-    AiObjectContext::BuildAllSharedContexts();
+    startup.Add("item caches", []() { sRandomItemMgr->Init(); });
+    startup.Add("item weight scales", []() { sRandomItemMgr->InitAfterAhBot(); }, {"item caches"});
+    startup.Add("bot texts", []() { sPlayerbotTextMgr->LoadBotTexts(); });
+    startup.Add("bot text chances", []() { sPlayerbotTextMgr->LoadBotTextChance(); }, {"bot texts"});
+    // Skips test gems, which are collected by the item info cache
+    startup.Add("factory quests and enchants", []() { PlayerbotFactory::Init(); }, {"item caches"});
+    startup.Add("shared contexts", []() { AiObjectContext::BuildAllSharedContexts(); });
 
     if (sPlayerbotAIConfig->randomBotSuggestDungeons)
     {
-        sPlayerbotDungeonRepository->LoadDungeonSuggestions();
+        startup.Add("dungeon suggestions", []() { sPlayerbotDungeonRepository->LoadDungeonSuggestions(); });
     }
 
+    startup.Run(startupThreads);
+    indexesBuilt = true;
+
+    sPlayerbotActivityGovernor->Init();
+
     excludedHunterPetFamilies.clear();
     LoadList<std::vector<uint32>>(sConfigMgr->GetOption<std::string>("AiPlayerbot.ExcludedHunterPetFamilies", ""), excludedHunterPetFamilies);
 
@@ -77,6 +77,9 @@ public:
     bool IsInPvpProhibitedArea(uint32 id);
 
     bool enabled;
+    uint32 startupThreads;
+    std::unordered_map<std::string, uint32> valueCacheCapacities;
+    std::string travelNodeSnapshot;
     bool disabledWithoutRealPlayer;
     bool EnableICCBuffs;
     bool allowAccountBots, allowGuildBots, allowTrustedAccountBots;
@@ -135,6 +138,8 @@ public:
     uint32 permanentlyInWorldTime;
     uint32 minRandomBotPvpTime, maxRandomBotPvpTime;
     uint32 randomBotsPerInterval;
+    uint32 randomBotLoginMaxDiff;
+    uint32 repositoryFlushInterval;
     uint32 minRandomBotsPriceChangeInterval, maxRandomBotsPriceChangeInterval;
     uint32 disabledWithoutRealPlayerLoginDelay, disabledWithoutRealPlayerLogoutDelay;
     bool randomBotJoinLfg;
@@ -156,6 +161,8 @@ public:
     bool enableBroadcasts;
     bool enableGreet;
     bool randomBotSayWithoutMaster;
+    uint32 channelCommandMaxBots;
+    uint32 channelBotIndexRefreshInterval;
 
     uint32 broadcastChanceMaxValue;
 
@@ -340,6 +347,14 @@ public:
     uint32 botActiveAloneSmartScaleDiffLimitCeiling;
     uint32 botActiveAloneSmartScaleWhenMinLevel;
     uint32 botActiveAloneSmartScaleWhenMaxLevel;
+    bool activityGovernorEnabled;
+    uint32 activityGovernorTargetDiff;
+    uint32 activityGovernorInterval;
+    float activityGovernorKp, activityGovernorKi, activityGovernorKd;
+    uint32 activityGovernorReducedBand;
+    uint32 activityGovernorReducedTickInterval;
+    uint32 activityGovernorDormantTickInterval;
+    uint32 activityGovernorMetricsInterval;
 
     bool freeMethodLoot;
     int32 lootRollLevel;
@@ -347,6 +362,7 @@ public:
     bool autoEquipUpgradeLoot;
     float equipUpgradeThreshold;
     bool twoRoundsGearInit;
+    uint32 randomizePlanThreads;
     bool syncQuestWithPlayer;
     bool syncQuestForPlayer;
     bool dropObsoleteQuests;
@@ -449,6 +465,9 @@ public:
     bool IsRestrictedHealerDPSMap(uint32 mapId) const;
 
     std::vector<uint32> excludedHunterPetFamilies;
+
+private:
+    bool indexesBuilt = false;
 };
 
 #define sPlayerbotAIConfig PlayerbotAIConfig::instance()
@@ -14,12 +14,27 @@
  */
 
 #include "BattleGroundTactics.h"
+#include "BattleGroundTeamPlanner.h"
 #include "Chat.h"
+#include "EncounterBlackboard.h"
+#include "EncounterUnitRegistry.h"
 #include "GuildTaskMgr.h"
+#include "ItemUsageValue.h"
+#include "LootIndex.h"
+#include "ObjectAccessor.h"
 #include "PerfMonitor.h"
+#include "PlayerbotBuffCoverage.h"
+#include "PlayerbotGearScoreCache.h"
 #include "PlayerbotMgr.h"
+#include "PlayerbotStateVersions.h"
+#include "PlayerbotTextMgr.h"
+#include "Playerbots.h"
+#include "QuestPOIIndex.h"
 #include "RandomPlayerbotMgr.h"
+#include "ReagentSpellIndex.h"
 #include "ScriptMgr.h"
+#include "TaxiRouteTable.h"
+#include "TravelNodeSnapshot.h"
 
 using namespace Acore::ChatCommands;
 
@@ -32,6 +47,17 @@ public:
     {
         static ChatCommandTable playerbotsDebugCommandTable = {
             {"bg", HandleDebugBGCommand, SEC_GAMEMASTER, Console::Yes},
+            {"bgplans", HandleDebugBGPlansCommand, SEC_GAMEMASTER, Console::Yes},
+            {"buffs", HandleDebugBuffsCommand, SEC_GAMEMASTER, Console::Yes},
+            {"encounters", HandleDebugEncountersCommand, SEC_GAMEMASTER, Console::Yes},
+            {"gearscore", HandleDebugGearScoreCommand, SEC_GAMEMASTER, Console::Yes},
+            {"itemusage", HandleDebugItemUsageCommand, SEC_GAMEMASTER, Console::Yes},
+            {"lootindex", HandleDebugLootIndexCommand, SEC_GAMEMASTER, Console::Yes},
+            {"questpois", HandleDebugQuestPOIsCommand, SEC_GAMEMASTER, Console::Yes},
+            {"taxiroutes", HandleDebugTaxiRoutesCommand, SEC_GAMEMASTER, Console::Yes},
+            {"texts", HandleDebugTextsCommand, SEC_GAMEMASTER, Console::Yes},
+            {"travelsnapshot", HandleDebugTravelSnapshotCommand, SEC_GAMEMASTER, Console::Yes},
+            {"values", HandleDebugValuesCommand, SEC_GAMEMASTER, Console::Yes},
         };
 
         static ChatCommandTable playerbotsAccountCommandTable = {
@@ -111,6 +137,161 @@ public:
         return BGTactics::HandleConsoleCommand(handler, args);
     }
 
+    static bool HandleDebugBGPlansCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sBattleGroundTeamPlanner->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugBuffsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sPlayerbotBuffCoverage->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugEncountersCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sEncounterBlackboardMgr->PrintStats(handler);
+        sEncounterUnitRegistry->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugGearScoreCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sPlayerbotGearScoreCache->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugItemUsageCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        ItemUsageValue::PrintStats(handler);
+        sReagentSpellIndex->PrintStats(handler);
+        sPlayerbotStateVersions->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugLootIndexCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sLootIndex->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugQuestPOIsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sQuestPOIIndex->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugTaxiRoutesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sTaxiRouteTable->PrintStats(handler);
+        return true;
+    }
+
+    static bool HandleDebugTextsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sPlayerbotTextMgr->PrintStats(handler);
+        return true;
+    }
+
+    // Travel node snapshot (AiPlayerbot.TravelNodeSnapshot): "build" writes it from the tables, else load stats
+    static bool HandleDebugTravelSnapshotCommand(ChatHandler* handler, char const* args)
+    {
+        std::string const path = TravelNodeSnapshot::GetConfiguredPath();
+        if (args && !strcmp(args, "build"))
+        {
+            if (path.empty())
+                handler->PSendSysMessage("Travel node snapshot is disabled (AiPlayerbot.TravelNodeSnapshot)");
+            else if (TravelNodeSnapshot::WriteFromDatabase(path))
+                handler->PSendSysMessage("Travel node snapshot written to {}", path);
+            else
+                handler->PSendSysMessage("Travel node snapshot could not be written, see the server log");
+
+            return true;
+        }
+
+        TravelNodeSnapshot::PrintStats(handler);
+        return true;
+    }
+
+    // Created AI objects per bot and evictions of the bounded value families (AiPlayerbot.ValueCacheCapacity)
+    static bool HandleDebugValuesCommand(ChatHandler* handler, char const* args)
+    {
+        std::string const name = args ? args : "";
+        if (!name.empty())
+        {
+            Player* bot = ObjectAccessor::FindPlayerByName(name);
+            PlayerbotAI* botAI = bot ? GET_PLAYERBOT_AI(bot) : nullptr;
+            if (!botAI)
+            {
+                handler->PSendSysMessage("{} is not an online bot", name);
+                return true;
+            }
+
+            AiObjectContext* context = botAI->GetAiObjectContext();
+            handler->PSendSysMessage("{}: {}", bot->GetName(), context->FormatObjectStats());
+            for (auto const& family : context->GetValueFamilies())
+                handler->PSendSysMessage("    {}: {}/{} values, {} evicted", family.name, family.order.size(),
+                                         family.capacity, family.evictions);
+
+            return true;
+        }
+
+        struct FamilyTotal
+        {
+            uint64 size = 0;
+            uint64 evictions = 0;
+        };
+
+        uint32 bots = 0;
+        uint64 values = 0;
+        uint64 bytes = 0;
+        uint64 maxBytes = 0;
+        std::string maxBot;
+        std::map<std::string, FamilyTotal> families;
+
+        std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+        HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
+        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        {
+            PlayerbotAI* botAI = GET_PLAYERBOT_AI(itr->second);
+            if (!botAI)
+                continue;
+
+            AiObjectContext* context = botAI->GetAiObjectContext();
+            uint64 const size = context->GetEstimatedSize();
+
+            ++bots;
+            values += context->GetValues().size();
+            bytes += size;
+            if (size > maxBytes)
+            {
+                maxBytes = size;
+                maxBot = itr->second->GetName();
+            }
+
+            for (auto const& family : context->GetValueFamilies())
+            {
+                families[family.name].size += family.order.size();
+                families[family.name].evictions += family.evictions;
+            }
+        }
+
+        if (!bots)
+        {
+            handler->PSendSysMessage("No bots online");
+            return true;
+        }
+
+        handler->PSendSysMessage("{} bots: {} values, ~{} KB ({} KB per bot, largest {} with {} KB)", bots, values,
+                                 bytes / 1024, bytes / bots / 1024, maxBot, maxBytes / 1024);
+        for (auto const& itr : families)
+            handler->PSendSysMessage("    {}: {} values, {} evicted", itr.first, itr.second.size,
+                                     itr.second.evictions);
+
+        return true;
+    }
+
     static bool HandleSetSecurityKeyCommand(ChatHandler* handler, char const* args)
     {
         if (!args || !*args)
@@ -17,22 +17,35 @@
 
 #include "Playerbots.h"
 
+#include "AllCreatureScript.h"
 #include "Channel.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
+#include "EncounterBlackboard.h"
+#include "EncounterUnitRegistry.h"
 #include "GuildTaskMgr.h"
 #include "Metric.h"
 #include "PlayerScript.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotActivityGovernor.h"
+#include "PlayerbotBuffCoverage.h"
+#include "PlayerbotFactoryPlanner.h"
+#include "PlayerbotGearScoreCache.h"
 #include "PlayerbotGuildMgr.h"
-#include "PlayerbotSpellRepository.h"
+#include "PlayerbotRepository.h"
+#include "PlayerbotStateVersions.h"
 #include "PlayerbotWorldThreadProcessor.h"
+#include "RaidIccStrategy.h"
 #include "RandomPlayerbotMgr.h"
+#include "ReagentSpellIndex.h"
 #include "ScriptMgr.h"
+#include "SpellAuras.h"
+#include "UnitScript.h"
 #include "PlayerbotCommandScript.h"
 #include "cmath"
 #include "BattleGroundTactics.h"
+#include "BattleGroundTeamPlanner.h"
 
 class PlayerbotsDatabaseScript : public DatabaseScript
 {
@@ -91,7 +104,17 @@ public:
         PLAYERHOOK_CAN_PLAYER_USE_GUILD_CHAT,
         PLAYERHOOK_CAN_PLAYER_USE_CHANNEL_CHAT,
         PLAYERHOOK_ON_GIVE_EXP,
-        PLAYERHOOK_ON_BEFORE_TELEPORT
+        PLAYERHOOK_ON_BEFORE_TELEPORT,
+        PLAYERHOOK_ON_EQUIP,
+        PLAYERHOOK_ON_AFTER_SET_VISIBLE_ITEM_SLOT,
+        PLAYERHOOK_ON_STORE_NEW_ITEM,
+        PLAYERHOOK_ON_AFTER_MOVE_ITEM_FROM_INVENTORY,
+        PLAYERHOOK_ON_LEVEL_CHANGED,
+        PLAYERHOOK_ON_LEARN_SPELL,
+        PLAYERHOOK_ON_FORGOT_SPELL,
+        PLAYERHOOK_ON_UPDATE_SKILL,
+        PLAYERHOOK_ON_PLAYER_COMPLETE_QUEST,
+        PLAYERHOOK_ON_QUEST_ABANDON
     }) {}
 
     void OnPlayerLogin(Player* player) override
@@ -125,6 +148,64 @@ public:
         }
     }
 
+    // Gear score changes, equip / unequip update the visible slot, bag items come and go by store and move out
+    void OnPlayerEquip(Player* player, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/, bool /*update*/) override
+    {
+        sPlayerbotGearScoreCache->Invalidate(player->GetGUID());
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_INVENTORY);
+    }
+
+    void OnPlayerAfterSetVisibleItemSlot(Player* player, uint8 /*slot*/, Item* /*item*/) override
+    {
+        sPlayerbotGearScoreCache->Invalidate(player->GetGUID());
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_INVENTORY);
+    }
+
+    void OnPlayerStoreNewItem(Player* player, Item* /*item*/, uint32 /*count*/) override
+    {
+        sPlayerbotGearScoreCache->Invalidate(player->GetGUID());
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_INVENTORY);
+    }
+
+    void OnPlayerAfterMoveItemFromInventory(Player* player, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/,
+                                            bool /*update*/) override
+    {
+        sPlayerbotGearScoreCache->Invalidate(player->GetGUID());
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_INVENTORY);
+    }
+
+    // Item usage depends on the level, the known spells and skills and the quest log
+    void OnPlayerLevelChanged(Player* player, uint8 /*oldlevel*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_LEVEL);
+    }
+
+    void OnPlayerLearnSpell(Player* player, uint32 /*spellID*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_SPELLS);
+    }
+
+    void OnPlayerForgotSpell(Player* player, uint32 /*spellID*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_SPELLS);
+    }
+
+    void OnPlayerUpdateSkill(Player* player, uint32 /*skillId*/, uint32 /*value*/, uint32 /*max*/, uint32 /*step*/,
+                             uint32 /*newValue*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_SPELLS);
+    }
+
+    void OnPlayerCompleteQuest(Player* player, Quest const* /*quest*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_QUESTS);
+    }
+
+    void OnPlayerQuestAbandon(Player* player, uint32 /*questId*/) override
+    {
+        sPlayerbotStateVersions->Bump(player->GetGUID(), PLAYER_STATE_QUESTS);
+    }
+
     bool OnPlayerBeforeTeleport(Player* /*player*/, uint32 /*mapid*/, float /*x*/, float /*y*/, float /*z*/, float /*orientation*/, uint32 /*options*/, Unit* /*target*/) override
     {
         /* for now commmented out until proven its actually required
@@ -248,7 +329,7 @@ public:
             }
         }
 
-        sRandomPlayerbotMgr->HandleCommand(type, msg, player);
+        sRandomPlayerbotMgr->HandleChannelCommand(channel, type, msg, player);
         return true;
     }
 
@@ -296,6 +377,44 @@ public:
     }
 };
 
+class PlayerbotsUnitScript : public UnitScript
+{
+public:
+    PlayerbotsUnitScript() : UnitScript("PlayerbotsUnitScript", true, {
+        UNITHOOK_ON_AURA_APPLY,
+        UNITHOOK_ON_AURA_REMOVE
+    }) {}
+
+    void OnAuraApply(Unit* unit, Aura* aura) override
+    {
+        sPlayerbotBuffCoverage->OnAuraApply(unit, aura);
+    }
+
+    void OnAuraRemove(Unit* unit, AuraApplication* aurApp, AuraRemoveMode /*mode*/) override
+    {
+        sPlayerbotBuffCoverage->OnAuraRemove(unit, aurApp->GetBase());
+    }
+};
+
+class PlayerbotsAllCreatureScript : public AllCreatureScript
+{
+public:
+    PlayerbotsAllCreatureScript() : AllCreatureScript("PlayerbotsAllCreatureScript", {
+        ALLCREATUREHOOK_ON_CREATURE_ADD_WORLD,
+        ALLCREATUREHOOK_ON_CREATURE_REMOVE_WORLD
+    }) {}
+
+    void OnCreatureAddWorld(Creature* creature) override
+    {
+        sEncounterUnitRegistry->OnAddToWorld(creature);
+    }
+
+    void OnCreatureRemoveWorld(Creature* creature) override
+    {
+        sEncounterUnitRegistry->OnRemoveFromWorld(creature);
+    }
+};
+
 class PlayerbotsMiscScript : public MiscScript
 {
 public:
@@ -335,7 +454,8 @@ class PlayerbotsWorldScript : public WorldScript
 public:
     PlayerbotsWorldScript() : WorldScript("PlayerbotsWorldScript", {
         WORLDHOOK_ON_BEFORE_WORLD_INITIALIZED,
-        WORLDHOOK_ON_UPDATE
+        WORLDHOOK_ON_UPDATE,
+        WORLDHOOK_ON_SHUTDOWN
     }) {}
 
     void OnBeforeWorldInitialized() override
@@ -365,7 +485,7 @@ public:
         LOG_INFO("server.loading", ">> Loaded playerbots config in {} ms", GetMSTimeDiffToNow(oldMSTime));
         LOG_INFO("server.loading", " ");
 
-        sPlayerbotSpellRepository->Initialize();
+        RaidIccStrategy::TrackEncounterUnits();
 
         LOG_INFO("server.loading", "Playerbots World Thread Processor initialized");
     }
@@ -373,8 +493,18 @@ public:
     void OnUpdate(uint32 diff) override
     {
         sPlayerbotWorldProcessor->Update(diff);
+        sPlayerbotActivityGovernor->Update(diff);  // World thread only
+        sPlayerbotRepository->Update(diff);        // World thread only
+        sPlayerbotFactoryPlanner->Update();        // World thread only
+        sEncounterBlackboardMgr->Update(diff);     // World thread only
         sRandomPlayerbotMgr->UpdateAI(diff);  // World thread only
     }
+
+    void OnShutdown() override
+    {
+        // Planner workers read the item and spell stores, stop them before the core frees those
+        sPlayerbotFactoryPlanner->Stop();
+    }
 };
 
 class PlayerbotsScript : public PlayerbotScript
@@ -457,6 +587,11 @@ public:
         }
 
         sRandomPlayerbotMgr->OnPlayerLogout(player);
+        sPlayerbotFactoryPlanner->OnLogout(player);
+        sPlayerbotBuffCoverage->OnLogout(player->GetGUID());
+        sPlayerbotGearScoreCache->OnLogout(player->GetGUID());
+        sPlayerbotStateVersions->OnLogout(player->GetGUID());
+        sReagentSpellIndex->OnLogout(player->GetGUID());
     }
 
     void OnPlayerbotLogoutBots() override
@@ -500,7 +635,11 @@ public:
         bgStrategies[bg->GetInstanceID()] = data;
     }
 
-    void OnBattlegroundEnd(Battleground* bg, TeamId /*winnerTeam*/) override { bgStrategies.erase(bg->GetInstanceID()); }
+    void OnBattlegroundEnd(Battleground* bg, TeamId /*winnerTeam*/) override
+    {
+        bgStrategies.erase(bg->GetInstanceID());
+        sBattleGroundTeamPlanner->OnBattlegroundEnd(bg->GetInstanceID());
+    }
 };
 
 void AddPlayerbotsSecureLoginScripts();
@@ -510,6 +649,8 @@ void AddPlayerbotsScripts()
     new PlayerbotsDatabaseScript();
     new PlayerbotsPlayerScript();
     new PlayerbotsMiscScript();
+    new PlayerbotsUnitScript();
+    new PlayerbotsAllCreatureScript();
     new PlayerbotsServerScript();
     new PlayerbotsWorldScript();
     new PlayerbotsScript();
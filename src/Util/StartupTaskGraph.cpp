@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "StartupTaskGraph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Log.h"
+#include "Timer.h"
+
+void StartupTaskGraph::Add(std::string const name, Task task, std::vector<std::string> const dependencies)
+{
+    if (index.find(name) != index.end())
+    {
+        LOG_ERROR("playerbots", "Startup task {} is added twice, ignoring the second one", name);
+        return;
+    }
+
+    index[name] = nodes.size();
+
+    Node node;
+    node.name = name;
+    node.task = task;
+    node.dependencies = dependencies;
+    nodes.push_back(node);
+}
+
+bool StartupTaskGraph::Link()
+{
+    for (uint32 i = 0; i < nodes.size(); ++i)
+    {
+        Node& node = nodes[i];
+        node.pending = 0;
+
+        for (std::string const& dependency : node.dependencies)
+        {
+            std::unordered_map<std::string, uint32>::const_iterator itr = index.find(dependency);
+            if (itr == index.end())
+            {
+                LOG_ERROR("playerbots", "Startup task {} depends on unknown task {}", node.name, dependency);
+                return false;
+            }
+
+            nodes[itr->second].dependents.push_back(i);
+            ++node.pending;
+        }
+    }
+
+    // Reject cycles up front, they would leave the workers waiting forever
+    std::vector<uint32> pending;
+    std::vector<uint32> ready;
+    for (uint32 i = 0; i < nodes.size(); ++i)
+    {
+        pending.push_back(nodes[i].pending);
+        if (!nodes[i].pending)
+            ready.push_back(i);
+    }
+
+    uint32 visited = 0;
+    while (!ready.empty())
+    {
+        uint32 const id = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        for (uint32 dependent : nodes[id].dependents)
+            if (!--pending[dependent])
+                ready.push_back(dependent);
+    }
+
+    if (visited != nodes.size())
+    {
+        LOG_ERROR("playerbots", "Startup task graph has a dependency cycle");
+        return false;
+    }
+
+    return true;
+}
+
+void StartupTaskGraph::Run(uint32 threads)
+{
+    uint32 const graphStart = getMSTime();
+
+    if (!Link())
+    {
+        // Never skip a cache because of a broken graph, fall back to the order the tasks were added in
+        threads = 1;
+        for (Node& node : nodes)
+        {
+            node.startTime = GetMSTimeDiffToNow(graphStart);
+            uint32 const taskStart = getMSTime();
+            node.task();
+            node.duration = GetMSTimeDiffToNow(taskStart);
+        }
+    }
+    else
+    {
+        std::mutex lock;
+        std::condition_variable changed;
+        std::deque<uint32> ready;
+        uint32 finished = 0;
+
+        for (uint32 i = 0; i < nodes.size(); ++i)
+            if (!nodes[i].pending)
+                ready.push_back(i);
+
+        auto worker = [&]()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (true)
+            {
+                changed.wait(guard, [&]() { return !ready.empty() || finished == nodes.size(); });
+                if (ready.empty())
+                    return;
+
+                Node& node = nodes[ready.front()];
+                ready.pop_front();
+
+                guard.unlock();
+                node.startTime = GetMSTimeDiffToNow(graphStart);
+                uint32 const taskStart = getMSTime();
+                node.task();
+                node.duration = GetMSTimeDiffToNow(taskStart);
+                guard.lock();
+
+                ++finished;
+                for (uint32 dependent : node.dependents)
+                    if (!--nodes[dependent].pending)
+                        ready.push_back(dependent);
+
+                changed.notify_all();
+            }
+        };
+
+        threads = std::max<uint32>(1, std::min<uint32>(threads, nodes.size()));
+
+        std::vector<std::thread> pool;
+        for (uint32 i = 1; i < threads; ++i)
+            pool.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : pool)
+            thread.join();
+    }
+
+    totalTime = GetMSTimeDiffToNow(graphStart);
+    LogTimings(threads);
+}
+
+void StartupTaskGraph::LogTimings(uint32 threads) const
+{
+    std::vector<Node const*> sorted;
+    uint32 taskTime = 0;
+    for (Node const& node : nodes)
+    {
+        sorted.push_back(&node);
+        taskTime += node.duration;
+    }
+
+    std::sort(sorted.begin(), sorted.end(),
+              [](Node const* lhs, Node const* rhs) { return lhs->startTime < rhs->startTime; });
+
+    LOG_INFO("playerbots", "Playerbots startup tasks:");
+    for (Node const* node : sorted)
+        LOG_INFO("playerbots", "    {:<32} start +{:>6} ms, took {:>6} ms", node->name, node->startTime, node->duration);
+
+    LOG_INFO("playerbots", ">> Playerbots startup: {} tasks on {} threads in {} ms (sum of tasks {} ms)", nodes.size(),
+             threads, totalTime, taskTime);
+}
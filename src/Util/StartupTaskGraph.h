@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_STARTUPTASKGRAPH_H
+#define _PLAYERBOT_STARTUPTASKGRAPH_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+
+// Runs startup cache builders on a small pool of threads. A task starts once all tasks it depends on have finished,
+// independent tasks run in parallel. Per-task timing and the total wall time are logged when the graph completes.
+class StartupTaskGraph
+{
+public:
+    typedef std::function<void()> Task;
+
+    void Add(std::string const name, Task task, std::vector<std::string> const dependencies = {});
+    // Blocks until every task has run. threads <= 1 runs all tasks on the calling thread in dependency order.
+    void Run(uint32 threads);
+
+    uint32 GetTotalTime() const { return totalTime; }
+
+private:
+    struct Node
+    {
+        std::string name;
+        Task task;
+        std::vector<std::string> dependencies;
+        std::vector<uint32> dependents;
+        uint32 pending = 0;
+        uint32 startTime = 0;
+        uint32 duration = 0;
+    };
+
+    bool Link();
+    void LogTimings(uint32 threads) const;
+
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, uint32> index;
+    uint32 totalTime = 0;
+};
+
+#endif